@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+
+#include <bluetooth/services/nus.h>
+
+#include <zephyr/logging/log.h>
+
+#include "batch_ctrl.h"
+#include "bridge_stats.h"
+
+LOG_MODULE_DECLARE(peripheral_uart);
+
+/* Arrival rate is sampled over windows of at least this length. */
+#define RATE_WINDOW_MS 20
+
+/* Link is considered idle and the arrival rate low when less than
+ * 1/LOW_RATE_FILL_DIV of a notification arrives per connection interval.
+ */
+#define LOW_RATE_FILL_DIV 4
+
+/* Interval assumed until the connection parameters are known. */
+#define DEFAULT_INTERVAL_US 30000
+
+BUILD_ASSERT(CONFIG_BT_NUS_BATCH_LATENCY_MIN <= CONFIG_BT_NUS_BATCH_LATENCY_MAX,
+	     "The minimum hold time must not exceed the maximum hold time");
+
+static uint32_t rate_bps;
+static uint32_t window_bytes;
+static int64_t window_start;
+static uint32_t interval_us = DEFAULT_INTERVAL_US;
+/* Notifications not yet acknowledged, per connection. Each notification
+ * goes to every subscribed connection, each acknowledging it separately.
+ */
+static atomic_t in_flight[CONFIG_BT_MAX_CONN];
+static const struct bt_gatt_attr *nus_tx_attr;
+
+/* The slowest connection decides when the next notification leaves. */
+static uint32_t in_flight_max(void)
+{
+	atomic_val_t max = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(in_flight); i++) {
+		max = MAX(max, atomic_get(&in_flight[i]));
+	}
+
+	return max;
+}
+
+static void rate_update(size_t len)
+{
+	int64_t now = k_uptime_get();
+	int64_t elapsed = now - window_start;
+	uint32_t sample;
+
+	window_bytes += len;
+
+	if (elapsed < RATE_WINDOW_MS) {
+		return;
+	}
+
+	sample = (uint64_t)window_bytes * MSEC_PER_SEC / elapsed;
+
+	/* Follow rate increases immediately so that aggregation starts with
+	 * the burst, and decay slowly to ride over short gaps. After a long
+	 * idle period the old estimate is meaningless.
+	 */
+	if ((sample > rate_bps) || (elapsed > (4 * RATE_WINDOW_MS))) {
+		rate_bps = sample;
+	} else {
+		rate_bps = (3 * rate_bps + sample) / 4;
+	}
+
+	window_bytes = 0;
+	window_start = now;
+}
+
+void batch_ctrl_update(size_t len, size_t max_payload, struct batch_ctrl_params *params)
+{
+	uint32_t per_interval;
+	uint32_t pending = in_flight_max();
+
+	rate_update(len);
+
+	per_interval = (uint64_t)rate_bps * interval_us / USEC_PER_SEC;
+
+	if ((pending == 0) && ((per_interval * LOW_RATE_FILL_DIV) < max_payload)) {
+		/* Trickle of data on an idle link: send it right away. */
+		params->threshold = 1;
+		params->hold_ms = CONFIG_BT_NUS_BATCH_LATENCY_MIN;
+		params->flush_on_eol = true;
+	} else {
+		/* Notifications already queued in the stack will not leave
+		 * before the next connection events, so aggregate what
+		 * arrives meanwhile.
+		 */
+		params->threshold = CLAMP((size_t)per_interval * (pending + 1), 1, max_payload);
+		params->hold_ms = CLAMP(rate_bps ? (params->threshold * MSEC_PER_SEC / rate_bps) : 0,
+					CONFIG_BT_NUS_BATCH_LATENCY_MIN,
+					CONFIG_BT_NUS_BATCH_LATENCY_MAX);
+		params->flush_on_eol = false;
+	}
+
+	BRIDGE_STATS_SET(batch_rate_bps, rate_bps);
+	BRIDGE_STATS_SET(batch_threshold, params->threshold);
+}
+
+static void conn_sent(struct bt_conn *conn, void *data)
+{
+	if (bt_gatt_is_subscribed(conn, nus_tx_attr, BT_GATT_CCC_NOTIFY)) {
+		atomic_inc(&in_flight[bt_conn_index(conn)]);
+	}
+}
+
+void batch_ctrl_sent(void)
+{
+	if (!nus_tx_attr) {
+		nus_tx_attr = bt_gatt_find_by_uuid(NULL, 0, BT_UUID_NUS_TX);
+	}
+
+	bt_conn_foreach(BT_CONN_TYPE_LE, conn_sent, NULL);
+
+	BRIDGE_STATS_SET(ble_tx_inflight, in_flight_max());
+}
+
+void batch_ctrl_tx_done(struct bt_conn *conn)
+{
+	atomic_t *pending = &in_flight[bt_conn_index(conn)];
+
+	if (atomic_get(pending) > 0) {
+		atomic_dec(pending);
+	}
+
+	BRIDGE_STATS_SET(ble_tx_inflight, in_flight_max());
+}
+
+static void interval_update(struct bt_conn *conn)
+{
+	struct bt_conn_info info;
+
+	if (!bt_conn_get_info(conn, &info)) {
+		interval_us = BT_CONN_INTERVAL_TO_US(info.le.interval);
+	}
+}
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	if (!err) {
+		interval_update(conn);
+	}
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	atomic_set(&in_flight[bt_conn_index(conn)], 0);
+	interval_us = DEFAULT_INTERVAL_US;
+}
+
+static void le_param_updated(struct bt_conn *conn, uint16_t interval, uint16_t latency,
+			     uint16_t timeout)
+{
+	interval_us = BT_CONN_INTERVAL_TO_US(interval);
+	LOG_DBG("Batching for connection interval %u us", interval_us);
+}
+
+BT_CONN_CB_DEFINE(batch_ctrl_conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+	.le_param_updated = le_param_updated,
+};
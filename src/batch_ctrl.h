@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BATCH_CTRL_H_
+#define BATCH_CTRL_H_
+
+/** @file
+ *  @brief Adaptive batching of UART data sent over Bluetooth LE
+ *
+ *  Feedback controller choosing how much UART data is aggregated into a
+ *  notification and for how long, from the UART arrival rate, the number of
+ *  notifications in flight and the connection interval. At low rate, data is
+ *  sent immediately. At high rate, notifications are filled up to the ATT
+ *  payload size within the configured latency bounds.
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <zephyr/sys_clock.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Batching decision for the data currently being aggregated. */
+struct batch_ctrl_params {
+	/** Send the notification once it holds this many bytes. */
+	size_t threshold;
+	/** Longest time the oldest aggregated byte may wait, or SYS_FOREVER_MS. */
+	int32_t hold_ms;
+	/** Send the notification when a line ending is aggregated. */
+	bool flush_on_eol;
+};
+
+#if defined(CONFIG_BT_NUS_BATCH_ADAPTIVE)
+
+/** @brief Update the batching decision.
+ *
+ *  Called for every buffer received from the UART.
+ *
+ *  @param len         Number of bytes received.
+ *  @param max_payload Largest notification payload on the current link.
+ *  @param params      Batching decision to update.
+ */
+void batch_ctrl_update(size_t len, size_t max_payload, struct batch_ctrl_params *params);
+
+/** @brief Account a notification handed over to the stack. */
+void batch_ctrl_sent(void);
+
+/** @brief Account a notification acknowledged by the stack.
+ *
+ *  @param conn Connection the notification was sent over.
+ */
+void batch_ctrl_tx_done(struct bt_conn *conn);
+
+#else
+
+static inline void batch_ctrl_update(size_t len, size_t max_payload,
+				     struct batch_ctrl_params *params)
+{
+	ARG_UNUSED(len);
+
+	params->threshold = max_payload;
+	params->hold_ms = SYS_FOREVER_MS;
+	params->flush_on_eol = true;
+}
+
+static inline void batch_ctrl_sent(void) {}
+
+static inline void batch_ctrl_tx_done(struct bt_conn *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+#endif /* CONFIG_BT_NUS_BATCH_ADAPTIVE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BATCH_CTRL_H_ */
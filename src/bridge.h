@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BRIDGE_H_
+#define BRIDGE_H_
+
+/** @file
+ *  @brief UART side of the bridge
+ *
+ *  Entry points of the UART pipeline implemented in main.c for the
+ *  transports other than the NUS service.
+ */
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Write data received over the air to the UART.
+ *
+ *  The data is copied into UART buffers and either transmitted right away
+ *  or queued behind the ongoing transmission. Data that cannot be buffered
+ *  is dropped and counted.
+ *
+ *  @param data Data to write.
+ *  @param len  Data length.
+ */
+void bridge_uart_write(const uint8_t *data, uint16_t len);
+
+/** @brief Write binary data to the UART.
+ *
+ *  Same as bridge_uart_write(), without the line ending handling.
+ *
+ *  @param data Data to write.
+ *  @param len  Data length.
+ */
+void bridge_uart_write_raw(const uint8_t *data, uint16_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BRIDGE_H_ */
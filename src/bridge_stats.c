@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#include <zephyr/logging/log.h>
+
+#include "bridge_stats.h"
+
+LOG_MODULE_DECLARE(peripheral_uart);
+
+STATS_NAME_START(bridge_stats)
+STATS_NAME(bridge_stats, uart_rx_bytes)
+STATS_NAME(bridge_stats, uart_tx_bytes)
+STATS_NAME(bridge_stats, ble_rx_bytes)
+STATS_NAME(bridge_stats, ble_tx_bytes)
+STATS_NAME(bridge_stats, ble_tx_pkts)
+STATS_NAME(bridge_stats, ble_tx_fail)
+STATS_NAME(bridge_stats, ble_rx_drop)
+STATS_NAME(bridge_stats, uart_tx_queued)
+STATS_NAME(bridge_stats, uart_tx_abort)
+STATS_NAME(bridge_stats, uart_rx_buf_fail)
+STATS_NAME(bridge_stats, uart_tx_drop)
+STATS_NAME(bridge_stats, rx_q_depth)
+STATS_NAME(bridge_stats, rx_q_peak)
+STATS_NAME(bridge_stats, tx_q_depth)
+STATS_NAME(bridge_stats, tx_q_peak)
+STATS_NAME(bridge_stats, lat_last_us)
+STATS_NAME(bridge_stats, lat_max_us)
+STATS_NAME(bridge_stats, lat_sum_us)
+STATS_NAME(bridge_stats, lat_cnt)
+STATS_NAME(bridge_stats, buf_alloc)
+STATS_NAME(bridge_stats, buf_free)
+STATS_NAME(bridge_stats, buf_alloc_fail)
+STATS_NAME(bridge_stats, buf_in_use)
+STATS_NAME(bridge_stats, buf_peak)
+STATS_NAME(bridge_stats, buf_leaked)
+STATS_NAME(bridge_stats, qos_nus_wait_ms)
+STATS_NAME(bridge_stats, qos_dfu_wait_ms)
+STATS_NAME(bridge_stats, dfu_bps_alone)
+STATS_NAME(bridge_stats, dfu_bps_shared)
+STATS_NAME(bridge_stats, batch_rate_bps)
+STATS_NAME(bridge_stats, batch_threshold)
+STATS_NAME(bridge_stats, ble_tx_inflight)
+STATS_NAME(bridge_stats, health_rec)
+STATS_NAME(bridge_stats, health_rec_ms)
+STATS_NAME(bridge_stats, health_rec_max_ms)
+STATS_NAME(bridge_stats, ce_events)
+STATS_NAME(bridge_stats, ce_tx_pkts)
+STATS_NAME(bridge_stats, ce_crc_err)
+STATS_NAME(bridge_stats, ce_used_us)
+STATS_NAME(bridge_stats, ce_unused_us)
+STATS_NAME(bridge_stats, ce_app_limited)
+STATS_NAME(bridge_stats, ce_link_limited)
+STATS_NAME(bridge_stats, phy_level)
+STATS_NAME(bridge_stats, phy_switches)
+STATS_NAME(bridge_stats, phy_rssi_neg)
+STATS_NAME(bridge_stats, phy_err_pct)
+STATS_NAME(bridge_stats, phy_goodput_bps)
+STATS_NAME(bridge_stats, bc_frames)
+STATS_NAME(bridge_stats, bc_bytes)
+STATS_NAME(bridge_stats, bc_fill_pct)
+STATS_NAME(bridge_stats, bc_dropped)
+STATS_NAME(bridge_stats, bc_set_err)
+STATS_NAME(bridge_stats, bc_idle)
+STATS_NAME(bridge_stats, bc_bps)
+STATS_NAME(bridge_stats, iso_delivered)
+STATS_NAME(bridge_stats, iso_late)
+STATS_NAME(bridge_stats, iso_lost)
+STATS_NAME(bridge_stats, iso_rx_lost)
+STATS_NAME(bridge_stats, gw_peers)
+STATS_NAME(bridge_stats, gw_up_bps)
+STATS_NAME(bridge_stats, gw_down_bps)
+STATS_NAME(bridge_stats, gw_frame_err)
+STATS_NAME(bridge_stats, gw_drop)
+STATS_NAME(bridge_stats, relay_down_bps)
+STATS_NAME(bridge_stats, relay_up_bps)
+STATS_NAME(bridge_stats, relay_lat_us)
+STATS_NAME(bridge_stats, relay_lat_max_us)
+STATS_NAME(bridge_stats, relay_drop)
+STATS_NAME(bridge_stats, rt_hops)
+STATS_NAME(bridge_stats, rt_bps)
+STATS_NAME(bridge_stats, rt_lat_us)
+STATS_NAME(bridge_stats, rt_lat_max_us)
+STATS_NAME(bridge_stats, chan_rx_drop)
+STATS_NAME(bridge_stats, chan_rx_paused)
+STATS_NAME(bridge_stats, lane_hi_bufs)
+STATS_NAME(bridge_stats, lane_hi_delay_us)
+STATS_NAME(bridge_stats, lane_hi_max_us)
+STATS_NAME(bridge_stats, lane_lo_delay_us)
+STATS_NAME(bridge_stats, lane_lo_max_us)
+STATS_NAME(bridge_stats, lane_split_fail)
+STATS_NAME(bridge_stats, rel_goodput_bps)
+STATS_NAME(bridge_stats, rel_retx)
+STATS_NAME(bridge_stats, rel_retx_pct)
+STATS_NAME(bridge_stats, rel_srtt_ms)
+STATS_NAME(bridge_stats, rel_lost_bytes)
+STATS_NAME(bridge_stats, rel_resume_ms)
+STATS_NAME(bridge_stats, rel_fallback)
+STATS_NAME(bridge_stats, dl_forced)
+STATS_NAME(bridge_stats, dl_misses)
+STATS_NAME(bridge_stats, dl_max_wait_us)
+STATS_NAME(bridge_stats, dl_fill_pct)
+STATS_NAME(bridge_stats, lpm_idle)
+STATS_NAME(bridge_stats, lpm_wakeups)
+STATS_NAME(bridge_stats, lpm_events_ps)
+STATS_NAME(bridge_stats, lpm_wake_lat_us)
+STATS_NAME(bridge_stats, lpm_wake_lat_max_us)
+STATS_NAME(bridge_stats, ulp_suspends)
+STATS_NAME(bridge_stats, ulp_suspended_ms)
+STATS_NAME(bridge_stats, ulp_wake_us)
+STATS_NAME(bridge_stats, ulp_wake_max_us)
+STATS_NAME(bridge_stats, wk_total_ps)
+STATS_NAME(bridge_stats, wk_timer_ps)
+STATS_NAME(bridge_stats, wk_uart_ps)
+STATS_NAME(bridge_stats, hp_uart_cb_ns)
+STATS_NAME(bridge_stats, hp_fill_ns)
+STATS_NAME(bridge_stats, hp_ble_rx_ns)
+STATS_NAME(bridge_stats, set_deferred)
+STATS_NAME(bridge_stats, set_coalesced)
+STATS_NAME(bridge_stats, set_written)
+STATS_NAME(bridge_stats, set_pending)
+STATS_NAME(bridge_stats, set_write_us)
+STATS_NAME(bridge_stats, set_write_max_us)
+STATS_NAME(bridge_stats, set_stall_us)
+STATS_NAME(bridge_stats, set_stall_max_us)
+STATS_NAME(bridge_stats, conn_first_rx_ms)
+STATS_NAME(bridge_stats, conn_first_tx_ms)
+STATS_NAME_END(bridge_stats);
+
+STATS_SECT_DECL(bridge_stats) bridge_stats;
+
+/* Buffers are allocated and freed both from the UART callback and from
+ * thread context, so keep the occupancy in an atomic and only mirror it
+ * into the statistics group.
+ */
+static atomic_t buf_in_use;
+static atomic_t queue_depth[2];
+
+/* Latency histogram, bucket n holds samples in [2^n, 2^(n+1)) microseconds.
+ * The last bucket also holds everything above.
+ */
+#define LAT_BUCKETS 22
+
+static uint32_t lat_hist[LAT_BUCKETS];
+
+int bridge_stats_init(void)
+{
+	int err;
+
+	err = STATS_INIT_AND_REG(bridge_stats, STATS_SIZE_32,
+				 BRIDGE_STATS_GROUP_NAME);
+	if (err) {
+		LOG_ERR("Cannot register statistics group (err: %d)", err);
+	}
+
+	return err;
+}
+
+void bridge_stats_buf_alloc(bool success)
+{
+	atomic_val_t in_use;
+
+	if (!success) {
+		STATS_INC(bridge_stats, buf_alloc_fail);
+		return;
+	}
+
+	STATS_INC(bridge_stats, buf_alloc);
+
+	in_use = atomic_inc(&buf_in_use) + 1;
+	bridge_stats.buf_in_use = in_use;
+
+	if (in_use > bridge_stats.buf_peak) {
+		bridge_stats.buf_peak = in_use;
+	}
+}
+
+void bridge_stats_buf_free(void)
+{
+	STATS_INC(bridge_stats, buf_free);
+	bridge_stats.buf_in_use = atomic_dec(&buf_in_use) - 1;
+}
+
+void bridge_stats_latency(uint32_t rx_cycles)
+{
+	uint32_t lat_us = k_cyc_to_us_floor32(k_cycle_get_32() - rx_cycles);
+
+	bridge_stats.lat_last_us = lat_us;
+	STATS_INCN(bridge_stats, lat_sum_us, lat_us);
+	STATS_INC(bridge_stats, lat_cnt);
+
+	if (lat_us > bridge_stats.lat_max_us) {
+		bridge_stats.lat_max_us = lat_us;
+	}
+
+	lat_hist[MIN(lat_us ? (31 - __builtin_clz(lat_us)) : 0, LAT_BUCKETS - 1)]++;
+}
+
+uint32_t bridge_stats_latency_percentile(uint8_t percent)
+{
+	uint32_t total = 0;
+	uint32_t rank;
+	uint32_t seen = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(lat_hist); i++) {
+		total += lat_hist[i];
+	}
+
+	if (total == 0) {
+		return 0;
+	}
+
+	rank = DIV_ROUND_UP((uint64_t)total * MIN(percent, 100), 100);
+
+	for (size_t i = 0; i < ARRAY_SIZE(lat_hist); i++) {
+		uint32_t low = BIT(i);
+
+		if (seen + lat_hist[i] < rank) {
+			seen += lat_hist[i];
+			continue;
+		}
+
+		/* Interpolate linearly inside the bucket. */
+		return low + (uint32_t)((uint64_t)low * (rank - seen) / lat_hist[i]);
+	}
+
+	return bridge_stats.lat_max_us;
+}
+
+void bridge_stats_queue_put(enum bridge_queue queue)
+{
+	atomic_val_t depth = atomic_inc(&queue_depth[queue]) + 1;
+
+	if (queue == BRIDGE_QUEUE_UART_RX) {
+		bridge_stats.rx_q_depth = depth;
+		bridge_stats.rx_q_peak = MAX(bridge_stats.rx_q_peak, depth);
+	} else {
+		bridge_stats.tx_q_depth = depth;
+		bridge_stats.tx_q_peak = MAX(bridge_stats.tx_q_peak, depth);
+	}
+}
+
+void bridge_stats_queue_get(enum bridge_queue queue)
+{
+	atomic_val_t depth = atomic_dec(&queue_depth[queue]) - 1;
+
+	if (queue == BRIDGE_QUEUE_UART_RX) {
+		bridge_stats.rx_q_depth = depth;
+	} else {
+		bridge_stats.tx_q_depth = depth;
+	}
+}
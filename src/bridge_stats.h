@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BRIDGE_STATS_H_
+#define BRIDGE_STATS_H_
+
+/** @file
+ *  @brief UART bridge statistics
+ *
+ *  Throughput, drop, latency and buffer allocator counters of the bridge,
+ *  registered as a Zephyr statistics group so that they can be read with
+ *  the MCUmgr stat command.
+ */
+
+#include <zephyr/types.h>
+#include <zephyr/toolchain.h>
+#include <zephyr/stats/stats.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Name of the statistics group as reported by MCUmgr. */
+#define BRIDGE_STATS_GROUP_NAME "nus_bridge"
+
+/** Queues of the bridge whose occupancy is tracked. */
+enum bridge_queue {
+	/** Data received from the UART, waiting to be sent over Bluetooth LE. */
+	BRIDGE_QUEUE_UART_RX,
+	/** Data received over Bluetooth LE, waiting to be sent to the UART. */
+	BRIDGE_QUEUE_UART_TX,
+};
+
+#if defined(CONFIG_BT_NUS_STATS)
+
+STATS_SECT_START(bridge_stats)
+/* Throughput */
+STATS_SECT_ENTRY32(uart_rx_bytes)
+STATS_SECT_ENTRY32(uart_tx_bytes)
+STATS_SECT_ENTRY32(ble_rx_bytes)
+STATS_SECT_ENTRY32(ble_tx_bytes)
+STATS_SECT_ENTRY32(ble_tx_pkts)
+/* Drops and failures */
+STATS_SECT_ENTRY32(ble_tx_fail)
+STATS_SECT_ENTRY32(ble_rx_drop)
+STATS_SECT_ENTRY32(uart_tx_queued)
+STATS_SECT_ENTRY32(uart_tx_abort)
+STATS_SECT_ENTRY32(uart_rx_buf_fail)
+STATS_SECT_ENTRY32(uart_tx_drop)
+/* Queue occupancy in buffers */
+STATS_SECT_ENTRY32(rx_q_depth)
+STATS_SECT_ENTRY32(rx_q_peak)
+STATS_SECT_ENTRY32(tx_q_depth)
+STATS_SECT_ENTRY32(tx_q_peak)
+/* UART RX to BLE TX latency of the oldest byte of each notification */
+STATS_SECT_ENTRY32(lat_last_us)
+STATS_SECT_ENTRY32(lat_max_us)
+STATS_SECT_ENTRY32(lat_sum_us)
+STATS_SECT_ENTRY32(lat_cnt)
+/* Buffer allocator */
+STATS_SECT_ENTRY32(buf_alloc)
+STATS_SECT_ENTRY32(buf_free)
+STATS_SECT_ENTRY32(buf_alloc_fail)
+STATS_SECT_ENTRY32(buf_in_use)
+STATS_SECT_ENTRY32(buf_peak)
+STATS_SECT_ENTRY32(buf_leaked)
+/* NUS and SMP DFU arbitration */
+STATS_SECT_ENTRY32(qos_nus_wait_ms)
+STATS_SECT_ENTRY32(qos_dfu_wait_ms)
+STATS_SECT_ENTRY32(dfu_bps_alone)
+STATS_SECT_ENTRY32(dfu_bps_shared)
+/* Adaptive batching */
+STATS_SECT_ENTRY32(batch_rate_bps)
+STATS_SECT_ENTRY32(batch_threshold)
+STATS_SECT_ENTRY32(ble_tx_inflight)
+/* Pipeline health monitor */
+STATS_SECT_ENTRY32(health_rec)
+STATS_SECT_ENTRY32(health_rec_ms)
+STATS_SECT_ENTRY32(health_rec_max_ms)
+/* Connection event utilization */
+STATS_SECT_ENTRY32(ce_events)
+STATS_SECT_ENTRY32(ce_tx_pkts)
+STATS_SECT_ENTRY32(ce_crc_err)
+STATS_SECT_ENTRY32(ce_used_us)
+STATS_SECT_ENTRY32(ce_unused_us)
+STATS_SECT_ENTRY32(ce_app_limited)
+STATS_SECT_ENTRY32(ce_link_limited)
+/* Adaptive PHY */
+STATS_SECT_ENTRY32(phy_level)
+STATS_SECT_ENTRY32(phy_switches)
+STATS_SECT_ENTRY32(phy_rssi_neg)
+STATS_SECT_ENTRY32(phy_err_pct)
+STATS_SECT_ENTRY32(phy_goodput_bps)
+/* Periodic advertising broadcast */
+STATS_SECT_ENTRY32(bc_frames)
+STATS_SECT_ENTRY32(bc_bytes)
+STATS_SECT_ENTRY32(bc_fill_pct)
+STATS_SECT_ENTRY32(bc_dropped)
+STATS_SECT_ENTRY32(bc_set_err)
+STATS_SECT_ENTRY32(bc_idle)
+STATS_SECT_ENTRY32(bc_bps)
+/* Isochronous transport */
+STATS_SECT_ENTRY32(iso_delivered)
+STATS_SECT_ENTRY32(iso_late)
+STATS_SECT_ENTRY32(iso_lost)
+STATS_SECT_ENTRY32(iso_rx_lost)
+/* Gateway */
+STATS_SECT_ENTRY32(gw_peers)
+STATS_SECT_ENTRY32(gw_up_bps)
+STATS_SECT_ENTRY32(gw_down_bps)
+STATS_SECT_ENTRY32(gw_frame_err)
+STATS_SECT_ENTRY32(gw_drop)
+/* Relay */
+STATS_SECT_ENTRY32(relay_down_bps)
+STATS_SECT_ENTRY32(relay_up_bps)
+STATS_SECT_ENTRY32(relay_lat_us)
+STATS_SECT_ENTRY32(relay_lat_max_us)
+STATS_SECT_ENTRY32(relay_drop)
+/* Relay chain tracing */
+STATS_SECT_ENTRY32(rt_hops)
+STATS_SECT_ENTRY32(rt_bps)
+STATS_SECT_ENTRY32(rt_lat_us)
+STATS_SECT_ENTRY32(rt_lat_max_us)
+/* Additional UART channels */
+STATS_SECT_ENTRY32(chan_rx_drop)
+STATS_SECT_ENTRY32(chan_rx_paused)
+/* Priority lanes, queueing delay of the last buffer and maximum */
+STATS_SECT_ENTRY32(lane_hi_bufs)
+STATS_SECT_ENTRY32(lane_hi_delay_us)
+STATS_SECT_ENTRY32(lane_hi_max_us)
+STATS_SECT_ENTRY32(lane_lo_delay_us)
+STATS_SECT_ENTRY32(lane_lo_max_us)
+STATS_SECT_ENTRY32(lane_split_fail)
+/* Reliable stream */
+STATS_SECT_ENTRY32(rel_goodput_bps)
+STATS_SECT_ENTRY32(rel_retx)
+STATS_SECT_ENTRY32(rel_retx_pct)
+STATS_SECT_ENTRY32(rel_srtt_ms)
+STATS_SECT_ENTRY32(rel_lost_bytes)
+STATS_SECT_ENTRY32(rel_resume_ms)
+STATS_SECT_ENTRY32(rel_fallback)
+/* Deadline-aware flushing */
+STATS_SECT_ENTRY32(dl_forced)
+STATS_SECT_ENTRY32(dl_misses)
+STATS_SECT_ENTRY32(dl_max_wait_us)
+STATS_SECT_ENTRY32(dl_fill_pct)
+/* Connection power management */
+STATS_SECT_ENTRY32(lpm_idle)
+STATS_SECT_ENTRY32(lpm_wakeups)
+STATS_SECT_ENTRY32(lpm_events_ps)
+STATS_SECT_ENTRY32(lpm_wake_lat_us)
+STATS_SECT_ENTRY32(lpm_wake_lat_max_us)
+/* Low-power UART reception */
+STATS_SECT_ENTRY32(ulp_suspends)
+STATS_SECT_ENTRY32(ulp_suspended_ms)
+STATS_SECT_ENTRY32(ulp_wake_us)
+STATS_SECT_ENTRY32(ulp_wake_max_us)
+/* CPU wake-ups */
+STATS_SECT_ENTRY32(wk_total_ps)
+STATS_SECT_ENTRY32(wk_timer_ps)
+STATS_SECT_ENTRY32(wk_uart_ps)
+/* Hot path */
+STATS_SECT_ENTRY32(hp_uart_cb_ns)
+STATS_SECT_ENTRY32(hp_fill_ns)
+STATS_SECT_ENTRY32(hp_ble_rx_ns)
+/* Settings write scheduler */
+STATS_SECT_ENTRY32(set_deferred)
+STATS_SECT_ENTRY32(set_coalesced)
+STATS_SECT_ENTRY32(set_written)
+STATS_SECT_ENTRY32(set_pending)
+STATS_SECT_ENTRY32(set_write_us)
+STATS_SECT_ENTRY32(set_write_max_us)
+STATS_SECT_ENTRY32(set_stall_us)
+STATS_SECT_ENTRY32(set_stall_max_us)
+/* Connection start-up */
+STATS_SECT_ENTRY32(conn_first_rx_ms)
+STATS_SECT_ENTRY32(conn_first_tx_ms)
+STATS_SECT_END;
+
+extern STATS_SECT_DECL(bridge_stats) bridge_stats;
+
+#define BRIDGE_STATS_INC(_var) STATS_INC(bridge_stats, _var)
+#define BRIDGE_STATS_INCN(_var, _n) STATS_INCN(bridge_stats, _var, _n)
+#define BRIDGE_STATS_SET(_var, _val) (bridge_stats._var = (_val))
+
+/** @brief Register the bridge statistics group.
+ *
+ *  Registration clears the counters, so it must be done before the bridge
+ *  starts moving data.
+ *
+ *  @return 0 on success, negative error code otherwise.
+ */
+int bridge_stats_init(void);
+
+/** @brief Account a buffer allocation attempt.
+ *
+ *  @param success True if the allocation succeeded.
+ */
+void bridge_stats_buf_alloc(bool success);
+
+/** @brief Account a buffer release. */
+void bridge_stats_buf_free(void);
+
+/** @brief Account the latency of data sent over Bluetooth LE.
+ *
+ *  @param rx_cycles Hardware cycle count at which the oldest byte of the
+ *                   sent data was received from the UART.
+ */
+void bridge_stats_latency(uint32_t rx_cycles);
+
+/** @brief Get a latency percentile.
+ *
+ *  The percentile is estimated from a logarithmic histogram of all latency
+ *  samples since boot.
+ *
+ *  @param percent Percentile to compute, from 1 to 100.
+ *
+ *  @return Latency in microseconds, or 0 if no sample was recorded.
+ */
+uint32_t bridge_stats_latency_percentile(uint8_t percent);
+
+/** @brief Account a buffer added to a queue.
+ *
+ *  @param queue Queue the buffer was added to.
+ */
+void bridge_stats_queue_put(enum bridge_queue queue);
+
+/** @brief Account a buffer removed from a queue.
+ *
+ *  @param queue Queue the buffer was removed from.
+ */
+void bridge_stats_queue_get(enum bridge_queue queue);
+
+#else
+
+#define BRIDGE_STATS_INC(_var)
+#define BRIDGE_STATS_INCN(_var, _n)
+#define BRIDGE_STATS_SET(_var, _val)
+
+static inline int bridge_stats_init(void)
+{
+	return 0;
+}
+
+static inline void bridge_stats_buf_alloc(bool success)
+{
+	ARG_UNUSED(success);
+}
+
+static inline void bridge_stats_buf_free(void) {}
+
+static inline void bridge_stats_latency(uint32_t rx_cycles)
+{
+	ARG_UNUSED(rx_cycles);
+}
+
+static inline uint32_t bridge_stats_latency_percentile(uint8_t percent)
+{
+	ARG_UNUSED(percent);
+
+	return 0;
+}
+
+static inline void bridge_stats_queue_put(enum bridge_queue queue)
+{
+	ARG_UNUSED(queue);
+}
+
+static inline void bridge_stats_queue_get(enum bridge_queue queue)
+{
+	ARG_UNUSED(queue);
+}
+
+#endif /* CONFIG_BT_NUS_STATS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BRIDGE_STATS_H_ */
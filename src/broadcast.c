@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/ring_buffer.h>
+
+#include <bluetooth/services/nus.h>
+
+#include <zephyr/logging/log.h>
+
+#include "bridge_stats.h"
+#include "broadcast.h"
+
+LOG_MODULE_DECLARE(peripheral_uart);
+
+#define DEVICE_NAME CONFIG_BT_DEVICE_NAME
+#define DEVICE_NAME_LEN (sizeof(DEVICE_NAME) - 1)
+
+/* Periodic advertising interval, in units of 1.25 ms. */
+#define BROADCAST_INTERVAL ((CONFIG_BT_NUS_BROADCAST_INTERVAL * 4) / 5)
+
+static const struct bt_data ad[] = {
+	BT_DATA(BT_DATA_NAME_COMPLETE, DEVICE_NAME, DEVICE_NAME_LEN),
+	BT_DATA_BYTES(BT_DATA_UUID128_ALL, BT_UUID_NUS_VAL),
+};
+
+RING_BUF_DECLARE(broadcast_buf, CONFIG_BT_NUS_BROADCAST_BUF_SIZE);
+static struct k_spinlock lock;
+
+static struct bt_le_ext_adv *adv_set;
+static struct k_work_delayable frame_work;
+
+static struct {
+	struct broadcast_frame_hdr hdr;
+	uint8_t data[CONFIG_BT_NUS_BROADCAST_FRAME_SIZE];
+} __packed frame;
+
+static uint16_t seq;
+/* Frames that the data rejected by broadcast_send() would have filled. */
+static uint32_t dropped;
+/* Length of the frame data not accepted by the controller yet. */
+static uint32_t pending_len;
+static int64_t updated_at;
+/* Average bytes per frame, in 1/16 byte. */
+static uint32_t bytes_avg;
+
+int broadcast_send(const uint8_t *data, size_t len)
+{
+	uint32_t frames = DIV_ROUND_UP(len, CONFIG_BT_NUS_BROADCAST_FRAME_SIZE);
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	int err = 0;
+
+	if (ring_buf_space_get(&broadcast_buf) < len) {
+		dropped += frames;
+		err = -ENOMEM;
+	} else {
+		ring_buf_put(&broadcast_buf, data, len);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (err) {
+		BRIDGE_STATS_INCN(bc_dropped, frames);
+	}
+
+	return err;
+}
+
+static void frame_work_handler(struct k_work *work)
+{
+	struct bt_data per_ad;
+	k_spinlock_key_t key;
+	int64_t elapsed;
+	uint32_t len;
+	int err;
+
+	/* The advertising data is sent once per periodic advertising event.
+	 * Keep each frame for at least a full interval, so that it spans one
+	 * event whatever the delay of this work item.
+	 */
+	elapsed = k_uptime_get() - updated_at;
+	if (elapsed < CONFIG_BT_NUS_BROADCAST_INTERVAL) {
+		k_work_reschedule(&frame_work, K_MSEC(CONFIG_BT_NUS_BROADCAST_INTERVAL - elapsed));
+		return;
+	}
+
+	k_work_reschedule(&frame_work, K_MSEC(CONFIG_BT_NUS_BROADCAST_INTERVAL));
+
+	if (pending_len == 0) {
+		key = k_spin_lock(&lock);
+		len = ring_buf_get(&broadcast_buf, frame.data, sizeof(frame.data));
+		frame.hdr.dropped = sys_cpu_to_le16((uint16_t)dropped);
+		k_spin_unlock(&lock, key);
+
+		bytes_avg = (bytes_avg * 7 + len * 16) / 8;
+		BRIDGE_STATS_SET(bc_bps, (bytes_avg * 8 * MSEC_PER_SEC) /
+					 (16 * CONFIG_BT_NUS_BROADCAST_INTERVAL));
+
+		if (len == 0) {
+			/* Keep the previous frame, receivers ignore repeated ones. */
+			BRIDGE_STATS_INC(bc_idle);
+			return;
+		}
+
+		frame.hdr.seq = sys_cpu_to_le16(++seq);
+		pending_len = len;
+	}
+
+	per_ad.type = BT_DATA_MANUFACTURER_DATA;
+	per_ad.data_len = sizeof(frame.hdr) + pending_len;
+	per_ad.data = (const uint8_t *)&frame;
+
+	err = bt_le_per_adv_set_data(adv_set, &per_ad, 1);
+	if (err) {
+		/* The data is already out of the ring, retry the same frame
+		 * at the next interval.
+		 */
+		LOG_WRN("Cannot update periodic advertising data (err %d)", err);
+		BRIDGE_STATS_INC(bc_set_err);
+		return;
+	}
+
+	updated_at = k_uptime_get();
+
+	BRIDGE_STATS_INC(bc_frames);
+	BRIDGE_STATS_INCN(bc_bytes, pending_len);
+	BRIDGE_STATS_SET(bc_fill_pct, 100 * pending_len / sizeof(frame.data));
+	pending_len = 0;
+}
+
+int broadcast_init(void)
+{
+	int err;
+
+	frame.hdr.company_id = sys_cpu_to_le16(BROADCAST_COMPANY_ID);
+
+	err = bt_le_ext_adv_create(BT_LE_EXT_ADV_NCONN, NULL, &adv_set);
+	if (err) {
+		LOG_ERR("Cannot create broadcast advertising set (err %d)", err);
+		return err;
+	}
+
+	err = bt_le_ext_adv_set_data(adv_set, ad, ARRAY_SIZE(ad), NULL, 0);
+	if (err) {
+		LOG_ERR("Cannot set broadcast advertising data (err %d)", err);
+		return err;
+	}
+
+	err = bt_le_per_adv_set_param(adv_set, BT_LE_PER_ADV_PARAM(BROADCAST_INTERVAL,
+								    BROADCAST_INTERVAL,
+								    BT_LE_PER_ADV_OPT_NONE));
+	if (err) {
+		LOG_ERR("Cannot set periodic advertising parameters (err %d)", err);
+		return err;
+	}
+
+	err = bt_le_per_adv_start(adv_set);
+	if (err) {
+		LOG_ERR("Cannot start periodic advertising (err %d)", err);
+		return err;
+	}
+
+	err = bt_le_ext_adv_start(adv_set, BT_LE_EXT_ADV_START_DEFAULT);
+	if (err) {
+		LOG_ERR("Cannot start broadcast advertising (err %d)", err);
+		return err;
+	}
+
+	k_work_init_delayable(&frame_work, frame_work_handler);
+	k_work_reschedule(&frame_work, K_MSEC(CONFIG_BT_NUS_BROADCAST_INTERVAL));
+
+	LOG_INF("Broadcasting on periodic advertising every %d ms, %d bytes per frame",
+		CONFIG_BT_NUS_BROADCAST_INTERVAL, CONFIG_BT_NUS_BROADCAST_FRAME_SIZE);
+
+	return 0;
+}
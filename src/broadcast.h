@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BROADCAST_H_
+#define BROADCAST_H_
+
+/** @file
+ *  @brief UART data broadcast over periodic advertising
+ *
+ *  Packetizes the data received from the UART into frames carried by a
+ *  periodic advertising train, so that any number of scanners synchronized
+ *  to the train receive the stream.
+ */
+
+#include <stddef.h>
+#include <zephyr/types.h>
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Company identifier of the manufacturer specific data carrying frames. */
+#define BROADCAST_COMPANY_ID 0x0059
+
+/** Frame header, little-endian, following the company identifier in the
+ *  manufacturer specific data of the periodic advertising data.
+ *
+ *  Receivers detect lost frames from gaps in the sequence number, and
+ *  ignore a frame received again with the same sequence number.
+ */
+struct broadcast_frame_hdr {
+	/** Company identifier, BROADCAST_COMPANY_ID. */
+	uint16_t company_id;
+	/** Frame sequence number. */
+	uint16_t seq;
+	/** Frames that the data dropped by the broadcaster since boot would
+	 *  have filled, modulo 65536.
+	 */
+	uint16_t dropped;
+} __packed;
+
+#if defined(CONFIG_BT_NUS_BROADCAST)
+
+/** @brief Start the periodic advertising train.
+ *
+ *  @return 0 on success, negative error code otherwise.
+ */
+int broadcast_init(void);
+
+/** @brief Queue data for broadcasting.
+ *
+ *  The data is dropped as a whole if it does not fit in the broadcast
+ *  buffer.
+ *
+ *  @param data Data to broadcast.
+ *  @param len  Data length.
+ *
+ *  @return 0 on success, -ENOMEM if the data was dropped.
+ */
+int broadcast_send(const uint8_t *data, size_t len);
+
+#else
+
+static inline int broadcast_init(void)
+{
+	return 0;
+}
+
+static inline int broadcast_send(const uint8_t *data, size_t len)
+{
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+}
+
+#endif /* CONFIG_BT_NUS_BROADCAST */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BROADCAST_H_ */
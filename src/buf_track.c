@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+
+#include <zephyr/logging/log.h>
+
+#include "buf_track.h"
+
+LOG_MODULE_DECLARE(peripheral_uart);
+
+static const char *const owner_names[BUF_OWNER_COUNT] = {
+	[BUF_OWNER_NONE] = "none",
+	[BUF_OWNER_UART_RX] = "uart_rx",
+	[BUF_OWNER_RX_QUEUE] = "rx_queue",
+	[BUF_OWNER_BLE_WRITE] = "ble_write",
+	[BUF_OWNER_BLE_RX] = "ble_rx",
+	[BUF_OWNER_TX_QUEUE] = "tx_queue",
+	[BUF_OWNER_UART_TX] = "uart_tx",
+};
+
+static sys_dlist_t outstanding = SYS_DLIST_STATIC_INIT(&outstanding);
+static struct k_spinlock lock;
+static uint32_t double_frees;
+
+void buf_track_alloc(struct buf_track *track, const char *site)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	sys_dnode_init(&track->node);
+	track->site = site;
+	track->alloc_ms = k_uptime_get_32();
+	track->owner = BUF_OWNER_NONE;
+	sys_dlist_append(&outstanding, &track->node);
+
+	k_spin_unlock(&lock, key);
+}
+
+static bool outstanding_find(const struct buf_track *track)
+{
+	struct buf_track *entry;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&outstanding, entry, node) {
+		if (entry == track) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool buf_track_free(struct buf_track *track)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	/* Look the record up instead of reading it: after a first free, the
+	 * record is part of freed memory that may already be reused.
+	 */
+	bool linked = outstanding_find(track);
+
+	if (linked) {
+		sys_dlist_remove(&track->node);
+	} else {
+		double_frees++;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (!linked) {
+		LOG_ERR("Double free of buffer %p", (void *)track);
+	}
+
+	return linked;
+}
+
+void buf_track_owner(struct buf_track *track, enum buf_owner owner)
+{
+	track->owner = owner;
+}
+
+uint32_t buf_track_outstanding(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t total = sys_dlist_len(&outstanding);
+
+	k_spin_unlock(&lock, key);
+
+	return total;
+}
+
+uint32_t buf_track_double_frees(void)
+{
+	return double_frees;
+}
+
+void buf_track_report(void)
+{
+	uint32_t per_owner[BUF_OWNER_COUNT] = {0};
+	uint32_t now = k_uptime_get_32();
+	uint32_t total = 0;
+	struct buf_track *track;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&outstanding, track, node) {
+		per_owner[track->owner]++;
+		total++;
+
+		if ((now - track->alloc_ms) >= CONFIG_BT_NUS_BUF_TRACKING_AGE_WARN) {
+			LOG_WRN("Buffer %p from %s held by %s for %u ms", (void *)track,
+				track->site, owner_names[track->owner], now - track->alloc_ms);
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+
+	LOG_INF("Outstanding buffers: %u (uart_rx %u, rx_queue %u, ble_write %u, ble_rx %u, "
+		"tx_queue %u, uart_tx %u, none %u), double frees: %u", total,
+		per_owner[BUF_OWNER_UART_RX], per_owner[BUF_OWNER_RX_QUEUE],
+		per_owner[BUF_OWNER_BLE_WRITE], per_owner[BUF_OWNER_BLE_RX],
+		per_owner[BUF_OWNER_TX_QUEUE], per_owner[BUF_OWNER_UART_TX],
+		per_owner[BUF_OWNER_NONE], double_frees);
+}
+
+#if CONFIG_BT_NUS_BUF_TRACKING_REPORT_INTERVAL > 0
+static void report_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(report_work, report_work_handler);
+
+static void report_work_handler(struct k_work *work)
+{
+	buf_track_report();
+	k_work_reschedule(&report_work, K_MSEC(CONFIG_BT_NUS_BUF_TRACKING_REPORT_INTERVAL));
+}
+
+static int buf_track_init(void)
+{
+	k_work_reschedule(&report_work, K_MSEC(CONFIG_BT_NUS_BUF_TRACKING_REPORT_INTERVAL));
+
+	return 0;
+}
+
+SYS_INIT(buf_track_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+#endif
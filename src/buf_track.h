@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BUF_TRACK_H_
+#define BUF_TRACK_H_
+
+/** @file
+ *  @brief Bridge buffer lifecycle tracking
+ *
+ *  Debug aid recording the allocation site, the current owner stage and the
+ *  age of every outstanding bridge buffer. Outstanding buffers are reported
+ *  periodically and double frees are detected and prevented.
+ */
+
+#include <stdbool.h>
+#include <zephyr/types.h>
+#include <zephyr/sys/dlist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Pipeline stage owning a buffer. */
+enum buf_owner {
+	BUF_OWNER_NONE,
+	/** Given to the UART driver for reception. */
+	BUF_OWNER_UART_RX,
+	/** Waiting in the UART RX queue. */
+	BUF_OWNER_RX_QUEUE,
+	/** Being aggregated by the Bluetooth LE write thread. */
+	BUF_OWNER_BLE_WRITE,
+	/** Being filled with data received over Bluetooth LE. */
+	BUF_OWNER_BLE_RX,
+	/** Waiting in the UART TX queue. */
+	BUF_OWNER_TX_QUEUE,
+	/** Given to the UART driver for transmission. */
+	BUF_OWNER_UART_TX,
+
+	BUF_OWNER_COUNT
+};
+
+/** Tracking record embedded in every bridge buffer. */
+struct buf_track {
+	sys_dnode_t node;
+	/** Function that allocated the buffer. */
+	const char *site;
+	/** Uptime at allocation, in milliseconds. */
+	uint32_t alloc_ms;
+	/** Current owner, as enum buf_owner. */
+	uint8_t owner;
+};
+
+/** @brief Start tracking a newly allocated buffer.
+ *
+ *  @param track Tracking record of the buffer.
+ *  @param site  Allocation site.
+ */
+void buf_track_alloc(struct buf_track *track, const char *site);
+
+/** @brief Stop tracking a buffer about to be freed.
+ *
+ *  @param track Tracking record of the buffer.
+ *
+ *  @retval true  The buffer can be freed.
+ *  @retval false The buffer is not outstanding, it was already freed. The
+ *                record is not accessed in that case.
+ */
+bool buf_track_free(struct buf_track *track);
+
+/** @brief Hand a buffer over to another stage.
+ *
+ *  @param track Tracking record of the buffer.
+ *  @param owner New owner.
+ */
+void buf_track_owner(struct buf_track *track, enum buf_owner owner);
+
+/** @brief Get the number of outstanding buffers.
+ *
+ *  @return Number of buffers allocated and not freed yet.
+ */
+uint32_t buf_track_outstanding(void);
+
+/** @brief Get the number of double frees detected.
+ *
+ *  @return Number of double frees detected since boot.
+ */
+uint32_t buf_track_double_frees(void);
+
+/** @brief Log all outstanding buffers. */
+void buf_track_report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUF_TRACK_H_ */
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/hci.h>
+#include <zephyr/net_buf.h>
+
+#include <sdc_hci_vs.h>
+
+#include <zephyr/logging/log.h>
+
+#include "bridge_stats.h"
+#include "conn_evt.h"
+
+LOG_MODULE_DECLARE(peripheral_uart);
+
+/* Inter frame space between packets of a connection event. */
+#define T_IFS_US 150
+/* Link layer overhead of a data packet: access address, header and CRC. */
+#define LL_OVERHEAD 9
+/* L2CAP and ATT headers of a notification. */
+#define NOTIFY_OVERHEAD 7
+
+/* Utilization thresholds used to attribute the bottleneck, in percent. */
+#define APP_LIMITED_UTILIZATION 50
+#define LINK_LIMITED_UTILIZATION 90
+
+struct conn_evt_window {
+	uint32_t events;
+	uint32_t tx_pkts;
+	uint32_t rx_pkts;
+	uint32_t crc_errors;
+	uint32_t notifications;
+	uint32_t notify_bytes;
+};
+
+/* Link quality counters and parameters, indexed by connection. */
+struct conn_evt_link {
+	uint16_t handle;
+	bool valid;
+	/* Peripheral link of the NUS service, the one reported. */
+	bool nus;
+	uint32_t interval_us;
+	uint8_t tx_phy;
+	struct conn_evt_counters counters;
+};
+
+static struct conn_evt_window window;
+static struct conn_evt_link links[CONFIG_BT_MAX_CONN];
+static struct k_spinlock lock;
+static struct k_work_delayable report_work;
+
+/* Air time of a packet carrying len bytes of payload. */
+static uint32_t packet_us(uint8_t tx_phy, uint32_t len)
+{
+	switch (tx_phy) {
+	case BT_GAP_LE_PHY_2M:
+		/* 2 bytes preamble, 4 us per byte. */
+		return (2 + LL_OVERHEAD + len) * 4;
+	case BT_GAP_LE_PHY_CODED:
+		/* Worst case S=8 coding, 64 us per byte plus the coded
+		 * preamble and coding indicator.
+		 */
+		return 80 + 256 + (LL_OVERHEAD + len) * 64;
+	default:
+		return (1 + LL_OVERHEAD + len) * 8;
+	}
+}
+
+static bool on_vs_evt(struct net_buf_simple *buf)
+{
+	const sdc_hci_subevent_vs_qos_conn_event_report_t *evt;
+	k_spinlock_key_t key;
+
+	if (net_buf_simple_pull_u8(buf) != SDC_HCI_SUBEVENT_VS_QOS_CONN_EVENT_REPORT) {
+		return false;
+	}
+
+	evt = (const void *)buf->data;
+
+	key = k_spin_lock(&lock);
+
+	for (size_t i = 0; i < ARRAY_SIZE(links); i++) {
+		struct conn_evt_counters *counters = &links[i].counters;
+
+		if (!links[i].valid || (links[i].handle != evt->conn_handle)) {
+			continue;
+		}
+
+		counters->tx_pkts += evt->tx_packet_count;
+		counters->rx_pkts += evt->rx_packet_count;
+		counters->crc_errors += evt->crc_error_count;
+		counters->naks += evt->nak_count;
+
+		if (links[i].nus) {
+			window.events++;
+			window.tx_pkts += evt->tx_packet_count;
+			window.rx_pkts += evt->rx_packet_count;
+			window.crc_errors += evt->crc_error_count;
+		}
+
+		break;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return true;
+}
+
+void conn_evt_notify_submitted(size_t len)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	window.notifications++;
+	window.notify_bytes += len;
+
+	k_spin_unlock(&lock, key);
+}
+
+void conn_evt_counters_get(struct bt_conn *conn, struct conn_evt_counters *out)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*out = links[bt_conn_index(conn)].counters;
+
+	k_spin_unlock(&lock, key);
+}
+
+static void report_work_handler(struct k_work *work)
+{
+	struct conn_evt_window w;
+	uint32_t interval_us = 0;
+	uint8_t tx_phy = BT_GAP_LE_PHY_1M;
+	uint32_t capacity_us;
+	uint32_t used_us;
+	uint32_t tx_payload;
+	uint32_t utilization;
+	const char *bottleneck = "none";
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	w = window;
+	memset(&window, 0, sizeof(window));
+
+	for (size_t i = 0; i < ARRAY_SIZE(links); i++) {
+		if (links[i].valid && links[i].nus) {
+			interval_us = links[i].interval_us;
+			tx_phy = links[i].tx_phy;
+			break;
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+
+	k_work_reschedule(&report_work, K_MSEC(CONFIG_BT_NUS_CONN_EVT_REPORT_INTERVAL));
+
+	if ((w.events == 0) || (interval_us == 0)) {
+		return;
+	}
+
+	/* Spread the notified data over the transmitted packets, the rest of
+	 * them being empty packets.
+	 */
+	tx_payload = w.tx_pkts ?
+		     (w.notify_bytes + w.notifications * NOTIFY_OVERHEAD) / w.tx_pkts : 0;
+
+	used_us = (w.tx_pkts * packet_us(tx_phy, tx_payload) + w.rx_pkts * packet_us(tx_phy, 0) +
+		   (w.tx_pkts + w.rx_pkts) * T_IFS_US) / w.events;
+	capacity_us = MIN(interval_us, CONFIG_BT_NUS_CONN_EVT_LEN);
+	utilization = MIN(100 * used_us / capacity_us, 100);
+
+	if ((utilization < APP_LIMITED_UTILIZATION) && (bridge_stats.rx_q_depth == 0)) {
+		/* Room left in the events and nothing waiting in the bridge. */
+		bottleneck = "application";
+		BRIDGE_STATS_INC(ce_app_limited);
+	} else if (utilization >= LINK_LIMITED_UTILIZATION) {
+		bottleneck = "link";
+		BRIDGE_STATS_INC(ce_link_limited);
+	}
+
+	BRIDGE_STATS_INCN(ce_events, w.events);
+	BRIDGE_STATS_INCN(ce_tx_pkts, w.tx_pkts);
+	BRIDGE_STATS_INCN(ce_crc_err, w.crc_errors);
+	BRIDGE_STATS_SET(ce_used_us, used_us);
+	BRIDGE_STATS_SET(ce_unused_us, capacity_us - MIN(used_us, capacity_us));
+
+	LOG_INF("Conn events: %u, TX pkts/event %u.%02u, used %u/%u us (%u%%), "
+		"notifications %u (%u B), bottleneck: %s",
+		w.events, w.tx_pkts / w.events, (100 * w.tx_pkts / w.events) % 100,
+		used_us, capacity_us, utilization, w.notifications, w.notify_bytes, bottleneck);
+}
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	struct conn_evt_link *link = &links[bt_conn_index(conn)];
+	struct bt_conn_info info;
+	uint16_t handle;
+	k_spinlock_key_t key;
+
+	if (err) {
+		return;
+	}
+
+	if (bt_conn_get_info(conn, &info) || bt_hci_get_conn_handle(conn, &handle)) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+	link->handle = handle;
+	link->valid = true;
+	/* Central links of the gateway and of the relay are not NUS links. */
+	link->nus = (info.role == BT_CONN_ROLE_PERIPHERAL);
+	link->interval_us = BT_CONN_INTERVAL_TO_US(info.le.interval);
+	link->tx_phy = BT_GAP_LE_PHY_1M;
+	link->counters = (struct conn_evt_counters){ 0 };
+	k_spin_unlock(&lock, key);
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	links[bt_conn_index(conn)].valid = false;
+	k_spin_unlock(&lock, key);
+}
+
+static void le_param_updated(struct bt_conn *conn, uint16_t interval, uint16_t latency,
+			     uint16_t timeout)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	links[bt_conn_index(conn)].interval_us = BT_CONN_INTERVAL_TO_US(interval);
+	k_spin_unlock(&lock, key);
+}
+
+#if defined(CONFIG_BT_USER_PHY_UPDATE)
+static void le_phy_updated(struct bt_conn *conn, struct bt_conn_le_phy_info *param)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	links[bt_conn_index(conn)].tx_phy = param->tx_phy;
+	k_spin_unlock(&lock, key);
+}
+#endif
+
+BT_CONN_CB_DEFINE(conn_evt_conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+	.le_param_updated = le_param_updated,
+#if defined(CONFIG_BT_USER_PHY_UPDATE)
+	.le_phy_updated = le_phy_updated,
+#endif
+};
+
+int conn_evt_init(void)
+{
+	sdc_hci_cmd_vs_qos_conn_event_report_enable_t *cmd;
+	struct net_buf *buf;
+	int err;
+
+	err = bt_hci_register_vnd_evt_cb(on_vs_evt);
+	if (err) {
+		LOG_ERR("Cannot register vendor event callback (err: %d)", err);
+		return err;
+	}
+
+	buf = bt_hci_cmd_create(SDC_HCI_OPCODE_CMD_VS_QOS_CONN_EVENT_REPORT_ENABLE, sizeof(*cmd));
+	if (!buf) {
+		return -ENOBUFS;
+	}
+
+	cmd = net_buf_add(buf, sizeof(*cmd));
+	cmd->enable = 1;
+
+	err = bt_hci_cmd_send_sync(SDC_HCI_OPCODE_CMD_VS_QOS_CONN_EVENT_REPORT_ENABLE, buf, NULL);
+	if (err) {
+		LOG_ERR("Cannot enable connection event reports (err: %d)", err);
+		return err;
+	}
+
+	k_work_init_delayable(&report_work, report_work_handler);
+	k_work_reschedule(&report_work, K_MSEC(CONFIG_BT_NUS_CONN_EVT_REPORT_INTERVAL));
+
+	return 0;
+}
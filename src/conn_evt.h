@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CONN_EVT_H_
+#define CONN_EVT_H_
+
+/** @file
+ *  @brief Connection event utilization metrics
+ *
+ *  Correlates the notifications submitted by the bridge with the QoS
+ *  connection event reports of the SoftDevice Controller to tell whether
+ *  throughput is limited by the application not supplying data or by the
+ *  link carrying few packets per connection event.
+ */
+
+#include <stddef.h>
+#include <zephyr/types.h>
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct bt_conn;
+
+/** Link quality counters accumulated over the events of a connection. */
+struct conn_evt_counters {
+	/** Packets transmitted by the controller. */
+	uint32_t tx_pkts;
+	/** Packets received by the controller. */
+	uint32_t rx_pkts;
+	/** Packets received with a CRC error. */
+	uint32_t crc_errors;
+	/** Packets not acknowledged by the peer. */
+	uint32_t naks;
+};
+
+#if defined(CONFIG_BT_NUS_CONN_EVT_STATS)
+
+/** @brief Enable the controller connection event reports.
+ *
+ *  Must be called after Bluetooth is enabled.
+ *
+ *  @return 0 on success, negative error code otherwise.
+ */
+int conn_evt_init(void);
+
+/** @brief Account a notification submitted to the stack.
+ *
+ *  @param len Notification payload length.
+ */
+void conn_evt_notify_submitted(size_t len);
+
+/** @brief Get the link quality counters of a connection.
+ *
+ *  @param conn     Connection.
+ *  @param counters Counters accumulated since the connection was established.
+ */
+void conn_evt_counters_get(struct bt_conn *conn, struct conn_evt_counters *counters);
+
+#else
+
+static inline int conn_evt_init(void)
+{
+	return 0;
+}
+
+static inline void conn_evt_notify_submitted(size_t len)
+{
+	ARG_UNUSED(len);
+}
+
+static inline void conn_evt_counters_get(struct bt_conn *conn,
+					 struct conn_evt_counters *counters)
+{
+	ARG_UNUSED(conn);
+	*counters = (struct conn_evt_counters){ 0 };
+}
+
+#endif /* CONFIG_BT_NUS_CONN_EVT_STATS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONN_EVT_H_ */
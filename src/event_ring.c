@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/linker/section_tags.h>
+#include <zephyr/drivers/hwinfo.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/shell/shell.h>
+
+#include <zephyr/logging/log.h>
+
+#include "event_ring.h"
+
+LOG_MODULE_DECLARE(peripheral_uart);
+
+#define EVENT_RING_MAGIC 0x4e555352 /* "NUSR" */
+#define EVENT_RING_SIZE CONFIG_BT_NUS_EVENT_RING_SIZE
+
+struct event_ring {
+	uint32_t magic;
+	uint32_t boot_count;
+	/* Number of events ever written, the newest one is at head - 1. */
+	uint32_t head;
+	struct event_entry entries[EVENT_RING_SIZE];
+	/* Complement of the magic, guards against partially retained RAM. */
+	uint32_t magic_inv;
+};
+
+static struct event_ring ring __noinit;
+static struct k_spinlock lock;
+
+static const char *const type_names[EVENT_TYPE_COUNT] = {
+	[EVENT_BOOT] = "boot",
+	[EVENT_ALLOC_FAIL] = "alloc_fail",
+	[EVENT_BLE_SEND_FAIL] = "ble_send_fail",
+	[EVENT_UART_RX_RESTART] = "uart_rx_restart",
+	[EVENT_CONNECTED] = "connected",
+	[EVENT_DISCONNECTED] = "disconnected",
+	[EVENT_CONN_PARAM] = "conn_param",
+	[EVENT_PHY] = "phy",
+	[EVENT_RECOVERY] = "recovery",
+	[EVENT_REBOOT] = "reboot",
+};
+
+static uint32_t reset_cause_get(void)
+{
+	uint32_t cause = 0;
+
+	if (IS_ENABLED(CONFIG_HWINFO) && !hwinfo_get_reset_cause(&cause)) {
+		hwinfo_clear_reset_cause();
+	}
+
+	return cause;
+}
+
+void event_ring_init(void)
+{
+	uint32_t cause = reset_cause_get();
+
+	if ((ring.magic != EVENT_RING_MAGIC) || (ring.magic_inv != ~EVENT_RING_MAGIC) ||
+	    (cause & RESET_POR)) {
+		memset(&ring, 0, sizeof(ring));
+		ring.magic = EVENT_RING_MAGIC;
+		ring.magic_inv = ~EVENT_RING_MAGIC;
+	} else {
+		LOG_INF("Retained %u events from previous boots",
+			MIN(ring.head, EVENT_RING_SIZE));
+	}
+
+	ring.boot_count++;
+	event_ring_log(EVENT_BOOT, 0, cause);
+}
+
+void event_ring_log(enum event_type type, uint16_t arg16, uint32_t arg32)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct event_entry *entry = &ring.entries[ring.head % EVENT_RING_SIZE];
+
+	entry->timestamp_ms = sys_cpu_to_le32(k_uptime_get_32());
+	entry->boot = ring.boot_count;
+	entry->type = type;
+	entry->arg16 = sys_cpu_to_le16(arg16);
+	entry->arg32 = sys_cpu_to_le32(arg32);
+	ring.head++;
+
+	k_spin_unlock(&lock, key);
+}
+
+ssize_t event_ring_read(void *buf, uint16_t len, uint16_t offset)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t count = MIN(ring.head, EVENT_RING_SIZE);
+	uint32_t first = ring.head - count;
+	size_t total = count * sizeof(struct event_entry);
+	uint8_t *dst = buf;
+	ssize_t read = 0;
+
+	while ((offset < total) && (read < len)) {
+		uint32_t idx = (first + offset / sizeof(struct event_entry)) % EVENT_RING_SIZE;
+		size_t in_entry = offset % sizeof(struct event_entry);
+		size_t chunk = MIN(sizeof(struct event_entry) - in_entry, len - read);
+
+		memcpy(&dst[read], (uint8_t *)&ring.entries[idx] + in_entry, chunk);
+		read += chunk;
+		offset += chunk;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return read;
+}
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	struct bt_conn_info info;
+
+	if (err || bt_conn_get_info(conn, &info)) {
+		return;
+	}
+
+	event_ring_log(EVENT_CONNECTED, info.le.interval, 0);
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	event_ring_log(EVENT_DISCONNECTED, reason, 0);
+}
+
+static void le_param_updated(struct bt_conn *conn, uint16_t interval, uint16_t latency,
+			     uint16_t timeout)
+{
+	event_ring_log(EVENT_CONN_PARAM, interval, latency);
+}
+
+#if defined(CONFIG_BT_USER_PHY_UPDATE)
+static void le_phy_updated(struct bt_conn *conn, struct bt_conn_le_phy_info *param)
+{
+	event_ring_log(EVENT_PHY, param->tx_phy, param->rx_phy);
+}
+#endif
+
+BT_CONN_CB_DEFINE(event_ring_conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+	.le_param_updated = le_param_updated,
+#if defined(CONFIG_BT_USER_PHY_UPDATE)
+	.le_phy_updated = le_phy_updated,
+#endif
+};
+
+#if defined(CONFIG_SHELL)
+static int cmd_events(const struct shell *sh, size_t argc, char **argv)
+{
+	struct event_entry entry;
+	uint16_t offset = 0;
+
+	shell_print(sh, "boot  time [ms]  event            arg16  arg32");
+
+	while (event_ring_read(&entry, sizeof(entry), offset) == sizeof(entry)) {
+		shell_print(sh, "%4u  %9u  %-15s  %5u  0x%08x", entry.boot,
+			    sys_le32_to_cpu(entry.timestamp_ms),
+			    (entry.type < EVENT_TYPE_COUNT) ? type_names[entry.type] : "?",
+			    sys_le16_to_cpu(entry.arg16), sys_le32_to_cpu(entry.arg32));
+		offset += sizeof(entry);
+	}
+
+	return 0;
+}
+
+static int cmd_events_clear(const struct shell *sh, size_t argc, char **argv)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	ring.head = 0;
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(bridge_events_cmds,
+	SHELL_CMD(clear, NULL, "Clear the event ring", cmd_events_clear),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_STATIC_SUBCMD_SET_CREATE(bridge_cmds,
+	SHELL_CMD(events, &bridge_events_cmds, "Show the retained event ring", cmd_events),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(bridge, &bridge_cmds, "UART bridge commands", NULL);
+#endif /* CONFIG_SHELL */
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef EVENT_RING_H_
+#define EVENT_RING_H_
+
+/** @file
+ *  @brief Post-mortem bridge event ring
+ *
+ *  Fixed-size ring of timestamped bridge events kept in RAM that is not
+ *  initialized at boot, so that the events leading to a warm reset, for
+ *  example by a watchdog, can be retrieved after it.
+ */
+
+#include <sys/types.h>
+#include <zephyr/types.h>
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Event types. */
+enum event_type {
+	/** Boot, arg32 holds the reset cause. */
+	EVENT_BOOT,
+	/** Buffer allocation failure. */
+	EVENT_ALLOC_FAIL,
+	/** Notification failure, arg16 holds the length, arg32 the error. */
+	EVENT_BLE_SEND_FAIL,
+	/** UART reception restarted, arg32 holds the error if it failed. */
+	EVENT_UART_RX_RESTART,
+	/** Connected, arg16 holds the connection interval. */
+	EVENT_CONNECTED,
+	/** Disconnected, arg16 holds the reason. */
+	EVENT_DISCONNECTED,
+	/** Connection parameters updated, arg16 holds the interval and arg32
+	 *  the peripheral latency.
+	 */
+	EVENT_CONN_PARAM,
+	/** PHY updated, arg16 holds the TX PHY and arg32 the RX PHY. */
+	EVENT_PHY,
+	/** Pipeline stage recovery started, arg16 holds the recovery count. */
+	EVENT_RECOVERY,
+	/** Reboot requested by the bridge. */
+	EVENT_REBOOT,
+
+	EVENT_TYPE_COUNT
+};
+
+/** Event record, little-endian. */
+struct event_entry {
+	/** Uptime of the boot the event belongs to, in milliseconds. */
+	uint32_t timestamp_ms;
+	/** Low byte of the boot counter. */
+	uint8_t boot;
+	/** Event type, as enum event_type. */
+	uint8_t type;
+	uint16_t arg16;
+	uint32_t arg32;
+} __packed;
+
+#if defined(CONFIG_BT_NUS_EVENT_RING)
+
+/** @brief Validate the retained ring and record the boot event.
+ *
+ *  The ring is cleared on power-on reset or if its content is corrupted.
+ */
+void event_ring_init(void);
+
+/** @brief Record an event.
+ *
+ *  Can be called from interrupt context.
+ *
+ *  @param type  Event type.
+ *  @param arg16 First event argument.
+ *  @param arg32 Second event argument.
+ */
+void event_ring_log(enum event_type type, uint16_t arg16, uint32_t arg32);
+
+/** @brief Read the ring content, oldest event first.
+ *
+ *  @param buf    Destination buffer.
+ *  @param len    Size of the destination buffer.
+ *  @param offset Offset in bytes in the ring content.
+ *
+ *  @return Number of bytes read.
+ */
+ssize_t event_ring_read(void *buf, uint16_t len, uint16_t offset);
+
+#else
+
+static inline void event_ring_init(void) {}
+
+static inline void event_ring_log(enum event_type type, uint16_t arg16, uint32_t arg32)
+{
+	ARG_UNUSED(type);
+	ARG_UNUSED(arg16);
+	ARG_UNUSED(arg32);
+}
+
+#endif /* CONFIG_BT_NUS_EVENT_RING */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVENT_RING_H_ */
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/crc.h>
+
+#include <bluetooth/services/nus.h>
+
+#include <zephyr/logging/log.h>
+
+#include "bridge.h"
+#include "bridge_stats.h"
+#include "gateway.h"
+#include "nus_central.h"
+
+LOG_MODULE_DECLARE(peripheral_uart);
+
+#define GATEWAY_DEVICES (CONFIG_BT_NUS_CENTRAL_MAX_LINKS + 1)
+
+enum parse_state {
+	PARSE_SYNC,
+	PARSE_ID,
+	PARSE_LEN,
+	PARSE_DATA,
+	PARSE_FCS,
+};
+
+/* Frame being received from the UART. */
+static struct {
+	enum parse_state state;
+	struct gateway_frame_hdr hdr;
+	uint8_t pos;
+	uint8_t data[UINT8_MAX];
+} rx_frame;
+
+/* Frame being written to the UART, only built from the Bluetooth receive
+ * context. The frame check sequence follows the data.
+ */
+static struct {
+	struct gateway_frame_hdr hdr;
+	uint8_t data[UINT8_MAX + 1];
+} __packed tx_frame;
+
+/* Bytes exchanged with each device, the local one last. */
+static atomic_t up_bytes[GATEWAY_DEVICES];
+static atomic_t down_bytes[GATEWAY_DEVICES];
+
+static struct k_work_delayable report_work;
+/* Central connected to the local NUS service. */
+static struct bt_conn *local_conn;
+
+static size_t device_index(uint8_t id)
+{
+	return (id == GATEWAY_ID_LOCAL) ? CONFIG_BT_NUS_CENTRAL_MAX_LINKS : id;
+}
+
+static uint8_t frame_fcs(const struct gateway_frame_hdr *hdr, const uint8_t *data)
+{
+	uint8_t fcs;
+
+	fcs = crc8_ccitt(GATEWAY_FCS_INIT, &hdr->id, sizeof(hdr->id) + sizeof(hdr->len));
+
+	return crc8_ccitt(fcs, data, hdr->len);
+}
+
+static bool device_valid(uint8_t id)
+{
+	return (id == GATEWAY_ID_LOCAL) || (id < CONFIG_BT_NUS_CENTRAL_MAX_LINKS);
+}
+
+static void device_received(uint8_t id, const uint8_t *data, uint16_t len)
+{
+	atomic_add(&up_bytes[device_index(id)], len);
+
+	tx_frame.hdr.sync = GATEWAY_SYNC;
+	tx_frame.hdr.id = id;
+
+	for (uint16_t pos = 0; pos < len; pos += tx_frame.hdr.len) {
+		tx_frame.hdr.len = MIN(len - pos, UINT8_MAX);
+		memcpy(tx_frame.data, &data[pos], tx_frame.hdr.len);
+		tx_frame.data[tx_frame.hdr.len] = frame_fcs(&tx_frame.hdr, tx_frame.data);
+
+		bridge_uart_write_raw((const uint8_t *)&tx_frame,
+				      sizeof(tx_frame.hdr) + tx_frame.hdr.len + 1);
+	}
+}
+
+void gateway_local_received(const uint8_t *data, uint16_t len)
+{
+	device_received(GATEWAY_ID_LOCAL, data, len);
+}
+
+static void device_send(uint8_t id, const uint8_t *data, uint8_t len)
+{
+	uint16_t max_payload;
+	uint16_t plen;
+	int err = 0;
+
+	if (id == GATEWAY_ID_LOCAL) {
+		max_payload = local_conn ? bt_nus_get_mtu(local_conn) : 0;
+	} else if (id < CONFIG_BT_NUS_CENTRAL_MAX_LINKS) {
+		max_payload = nus_central_max_payload(id);
+	} else {
+		max_payload = 0;
+	}
+
+	if (max_payload == 0) {
+		BRIDGE_STATS_INCN(gw_drop, len);
+		return;
+	}
+
+	for (uint8_t pos = 0; pos < len; pos += plen) {
+		plen = MIN(len - pos, max_payload);
+
+		if (id == GATEWAY_ID_LOCAL) {
+			err = bt_nus_send(local_conn, &data[pos], plen);
+		} else {
+			err = nus_central_send(id, &data[pos], plen);
+		}
+
+		if (err) {
+			LOG_WRN("Cannot send frame to device %u (err %d)", id, err);
+			BRIDGE_STATS_INCN(gw_drop, len - pos);
+			return;
+		}
+	}
+
+	atomic_add(&down_bytes[device_index(id)], len);
+}
+
+void gateway_uart_rx(const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		uint8_t byte = data[i];
+
+		switch (rx_frame.state) {
+		case PARSE_SYNC:
+			if (byte == GATEWAY_SYNC) {
+				rx_frame.state = PARSE_ID;
+			} else {
+				BRIDGE_STATS_INC(gw_frame_err);
+			}
+			break;
+
+		case PARSE_ID:
+			if (!device_valid(byte)) {
+				/* Not a frame start, look for the next one. */
+				BRIDGE_STATS_INC(gw_frame_err);
+				rx_frame.state = (byte == GATEWAY_SYNC) ? PARSE_ID : PARSE_SYNC;
+				break;
+			}
+
+			rx_frame.hdr.id = byte;
+			rx_frame.state = PARSE_LEN;
+			break;
+
+		case PARSE_LEN:
+			rx_frame.hdr.len = byte;
+			rx_frame.pos = 0;
+			rx_frame.state = byte ? PARSE_DATA : PARSE_FCS;
+			break;
+
+		case PARSE_DATA: {
+			size_t n = MIN(len - i, rx_frame.hdr.len - rx_frame.pos);
+
+			memcpy(&rx_frame.data[rx_frame.pos], &data[i], n);
+			rx_frame.pos += n;
+			i += n - 1;
+
+			if (rx_frame.pos == rx_frame.hdr.len) {
+				rx_frame.state = PARSE_FCS;
+			}
+			break;
+		}
+
+		case PARSE_FCS:
+			if (byte != frame_fcs(&rx_frame.hdr, rx_frame.data)) {
+				BRIDGE_STATS_INC(gw_frame_err);
+			} else if (rx_frame.hdr.len > 0) {
+				device_send(rx_frame.hdr.id, rx_frame.data, rx_frame.hdr.len);
+			}
+
+			rx_frame.state = PARSE_SYNC;
+			break;
+		}
+	}
+}
+
+static void report_work_handler(struct k_work *work)
+{
+	uint32_t up_total = 0;
+	uint32_t down_total = 0;
+
+	for (size_t i = 0; i < GATEWAY_DEVICES; i++) {
+		uint32_t up = atomic_clear(&up_bytes[i]);
+		uint32_t down = atomic_clear(&down_bytes[i]);
+
+		if (up || down) {
+			LOG_DBG("Device %d: up %u B, down %u B",
+				(i == CONFIG_BT_NUS_CENTRAL_MAX_LINKS) ? GATEWAY_ID_LOCAL : (int)i,
+				up, down);
+		}
+
+		up_total += up;
+		down_total += down;
+	}
+
+	up_total = (uint64_t)up_total * 8 * MSEC_PER_SEC / CONFIG_BT_NUS_GATEWAY_REPORT_INTERVAL;
+	down_total = (uint64_t)down_total * 8 * MSEC_PER_SEC /
+		     CONFIG_BT_NUS_GATEWAY_REPORT_INTERVAL;
+
+	BRIDGE_STATS_SET(gw_peers, nus_central_count());
+	BRIDGE_STATS_SET(gw_up_bps, up_total);
+	BRIDGE_STATS_SET(gw_down_bps, down_total);
+
+	LOG_INF("Gateway: %u peers, up %u bps, down %u bps", nus_central_count(), up_total,
+		down_total);
+
+	k_work_reschedule(&report_work, K_MSEC(CONFIG_BT_NUS_GATEWAY_REPORT_INTERVAL));
+}
+
+static void device_ready(uint8_t id)
+{
+	BRIDGE_STATS_SET(gw_peers, nus_central_count());
+}
+
+static void device_disconnected(uint8_t id)
+{
+	BRIDGE_STATS_SET(gw_peers, nus_central_count());
+}
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	struct bt_conn_info info;
+
+	if (!err && !local_conn && !bt_conn_get_info(conn, &info) &&
+	    (info.role == BT_CONN_ROLE_PERIPHERAL)) {
+		local_conn = bt_conn_ref(conn);
+	}
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	if (conn == local_conn) {
+		bt_conn_unref(local_conn);
+		local_conn = NULL;
+	}
+}
+
+BT_CONN_CB_DEFINE(gateway_conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+};
+
+static const struct nus_central_cb central_cb = {
+	.ready = device_ready,
+	.disconnected = device_disconnected,
+	.received = device_received,
+};
+
+int gateway_init(void)
+{
+	int err;
+
+	err = nus_central_init(&central_cb);
+	if (err) {
+		return err;
+	}
+
+	k_work_init_delayable(&report_work, report_work_handler);
+	k_work_reschedule(&report_work, K_MSEC(CONFIG_BT_NUS_GATEWAY_REPORT_INTERVAL));
+
+	return 0;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef GATEWAY_H_
+#define GATEWAY_H_
+
+/** @file
+ *  @brief NUS gateway
+ *
+ *  Multiplexes the data of the NUS peripherals connected through the
+ *  central links, and of the local NUS service, onto the UART in frames
+ *  identifying the device, and routes the frames received from the UART
+ *  back to their device.
+ */
+
+#include <stddef.h>
+#include <zephyr/types.h>
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** First byte of each frame. */
+#define GATEWAY_SYNC 0xA5
+
+/** Device identifier of the central connected to the local NUS service.
+ *  The peripherals are identified by their link index, from 0.
+ */
+#define GATEWAY_ID_LOCAL 0xFF
+
+/** Initial value of the frame check sequence. */
+#define GATEWAY_FCS_INIT 0xFF
+
+/** Frame header, followed by len bytes of data and a one-byte frame check
+ *  sequence: the CRC-8-CCITT of the identifier, the length and the data,
+ *  starting from GATEWAY_FCS_INIT.
+ */
+struct gateway_frame_hdr {
+	/** GATEWAY_SYNC. */
+	uint8_t sync;
+	/** Device identifier. */
+	uint8_t id;
+	/** Data length. */
+	uint8_t len;
+} __packed;
+
+#if defined(CONFIG_BT_NUS_GATEWAY)
+
+/** @brief Start connecting to NUS peripherals.
+ *
+ *  @return 0 on success, negative error code otherwise.
+ */
+int gateway_init(void);
+
+/** @brief Demultiplex data received from the UART.
+ *
+ *  Frames may span several calls. Complete frames with a valid frame check
+ *  sequence are sent to their device, others are dropped.
+ *
+ *  @param data Data received from the UART.
+ *  @param len  Data length.
+ */
+void gateway_uart_rx(const uint8_t *data, size_t len);
+
+/** @brief Multiplex data received on the local NUS service.
+ *
+ *  @param data Received data.
+ *  @param len  Data length.
+ */
+void gateway_local_received(const uint8_t *data, uint16_t len);
+
+#else
+
+static inline int gateway_init(void)
+{
+	return 0;
+}
+
+static inline void gateway_uart_rx(const uint8_t *data, size_t len)
+{
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+}
+
+static inline void gateway_local_received(const uint8_t *data, uint16_t len)
+{
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+}
+
+#endif /* CONFIG_BT_NUS_GATEWAY */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GATEWAY_H_ */
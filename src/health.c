@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/reboot.h>
+
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+
+#include "bridge_stats.h"
+#include "event_ring.h"
+#include "health.h"
+#include "settings_sched.h"
+
+LOG_MODULE_DECLARE(peripheral_uart);
+
+static sys_slist_t stages = SYS_SLIST_STATIC_INIT(&stages);
+static struct k_work_delayable health_work;
+
+static void stage_check(struct health_stage *stage)
+{
+	int64_t now = k_uptime_get();
+	uint32_t recovery_ms;
+
+	if (stage->stalled()) {
+		if (!stage->recovering) {
+			stage->recovering = true;
+			stage->stalled_at = now;
+			stage->recoveries++;
+			BRIDGE_STATS_INC(health_rec);
+			event_ring_log(EVENT_RECOVERY, MIN(stage->recoveries, UINT16_MAX), 0);
+			LOG_WRN("%s stalled, recovering (%u recoveries)", stage->name,
+				stage->recoveries);
+		}
+
+		stage->recover();
+		return;
+	}
+
+	if (!stage->recovering) {
+		return;
+	}
+
+	recovery_ms = now - stage->stalled_at;
+	stage->recovering = false;
+
+	BRIDGE_STATS_SET(health_rec_ms, recovery_ms);
+	BRIDGE_STATS_SET(health_rec_max_ms, MAX(bridge_stats.health_rec_max_ms, recovery_ms));
+	LOG_INF("%s recovered in %u ms", stage->name, recovery_ms);
+}
+
+static void health_work_handler(struct k_work *work)
+{
+	struct health_stage *stage;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&stages, stage, node) {
+		stage_check(stage);
+	}
+
+	k_work_reschedule(&health_work, K_MSEC(CONFIG_BT_NUS_HEALTH_PERIOD));
+}
+
+void health_init(void)
+{
+	k_work_init_delayable(&health_work, health_work_handler);
+	k_work_reschedule(&health_work, K_MSEC(CONFIG_BT_NUS_HEALTH_PERIOD));
+}
+
+void health_stage_register(struct health_stage *stage)
+{
+	sys_slist_append(&stages, &stage->node);
+}
+
+FUNC_NORETURN void health_reboot(const char *reason)
+{
+	LOG_ERR("Unrecoverable failure: %s, rebooting in %d ms", reason,
+		CONFIG_BT_NUS_HEALTH_REBOOT_DELAY);
+	LOG_PANIC();
+	event_ring_log(EVENT_REBOOT, 0, 0);
+	settings_sched_flush();
+
+	k_sleep(K_MSEC(CONFIG_BT_NUS_HEALTH_REBOOT_DELAY));
+	sys_reboot(SYS_REBOOT_COLD);
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef HEALTH_H_
+#define HEALTH_H_
+
+/** @file
+ *  @brief Bridge pipeline health monitor
+ *
+ *  Periodically checks the registered pipeline stages and resets the ones
+ *  that stalled, recording the number of recoveries and how long each
+ *  stage took to resume.
+ */
+
+#include <stdbool.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Pipeline stage supervised by the health monitor. */
+struct health_stage {
+	/** Name used in logs. */
+	const char *name;
+	/** Return true if the stage is stalled. */
+	bool (*stalled)(void);
+	/** Reset the stage. Called on every check while the stage is stalled. */
+	void (*recover)(void);
+
+	/* Internal state of the monitor. */
+	sys_snode_t node;
+	int64_t stalled_at;
+	bool recovering;
+	uint32_t recoveries;
+};
+
+/** @brief Start the periodic health checks. */
+void health_init(void);
+
+/** @brief Add a stage to the health checks.
+ *
+ *  @param stage Stage to supervise.
+ */
+void health_stage_register(struct health_stage *stage);
+
+/** @brief Reboot after an unrecoverable failure.
+ *
+ *  @param reason Description of the failure, for the logs.
+ */
+FUNC_NORETURN void health_reboot(const char *reason);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HEALTH_H_ */
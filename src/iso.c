@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/iso.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <zephyr/logging/log.h>
+
+#include "bridge.h"
+#include "bridge_stats.h"
+#include "iso.h"
+
+LOG_MODULE_DECLARE(peripheral_uart);
+
+struct iso_frame {
+	uint32_t rx_cycles;
+	uint32_t timestamp_us;
+	uint16_t len;
+	uint8_t data[ISO_FRAME_SIZE];
+};
+
+K_MSGQ_DEFINE(iso_frames, sizeof(struct iso_frame), CONFIG_BT_NUS_ISO_QUEUE_SIZE, 4);
+
+/* Two SDUs in flight keep the controller supplied while the next one is
+ * prepared once the sent callback frees a slot.
+ */
+#define ISO_SDUS_IN_FLIGHT 2
+
+NET_BUF_POOL_FIXED_DEFINE(iso_tx_pool, ISO_SDUS_IN_FLIGHT,
+			  BT_ISO_SDU_BUF_SIZE(CONFIG_BT_NUS_ISO_SDU_SIZE),
+			  CONFIG_BT_CONN_TX_USER_DATA_SIZE, NULL);
+
+static struct bt_iso_chan_io_qos iso_tx_qos = {
+	.sdu = CONFIG_BT_NUS_ISO_SDU_SIZE,
+	.rtn = CONFIG_BT_NUS_ISO_RTN,
+	.phy = BT_GAP_LE_PHY_2M,
+};
+
+#if defined(CONFIG_BT_NUS_ISO_CIS)
+static struct bt_iso_chan_io_qos iso_rx_qos;
+#endif
+
+static struct bt_iso_chan_qos iso_qos = {
+	.tx = &iso_tx_qos,
+#if defined(CONFIG_BT_NUS_ISO_CIS)
+	.rx = &iso_rx_qos,
+#endif
+};
+
+static struct bt_iso_chan iso_chan;
+static atomic_t iso_ready;
+static uint16_t seq_num;
+
+/* SDUs given to the stack and not reported sent yet. */
+static atomic_t in_flight;
+/* Whether each SDU in flight carries a frame, indexed by its position. */
+static atomic_t carrying;
+static uint32_t queued;
+static uint32_t completed;
+
+static void send_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(send_work, send_work_handler);
+
+static int iso_sdu_send(void)
+{
+	struct iso_sdu_hdr *hdr;
+	struct iso_frame frame;
+	struct net_buf *buf;
+	uint32_t age_us;
+	int err;
+
+	buf = net_buf_alloc(&iso_tx_pool, K_NO_WAIT);
+	if (!buf) {
+		return -ENOBUFS;
+	}
+
+	net_buf_reserve(buf, BT_ISO_CHAN_SEND_RESERVE);
+	hdr = net_buf_add(buf, sizeof(*hdr));
+
+	/* An SDU is sent every interval, without data if none is pending, so
+	 * that the sequence number follows the isochronous timeline. The
+	 * frame is only peeked at, it stays queued if the controller cannot
+	 * take the SDU and goes with the next one.
+	 */
+	frame.len = 0;
+	if (k_msgq_peek(&iso_frames, &frame) == 0) {
+		hdr->timestamp_us = sys_cpu_to_le32(frame.timestamp_us);
+		hdr->len = sys_cpu_to_le16(frame.len);
+		net_buf_add_mem(buf, frame.data, frame.len);
+	} else {
+		hdr->timestamp_us = 0;
+		hdr->len = 0;
+	}
+
+	err = bt_iso_chan_send(&iso_chan, buf, seq_num++);
+	if (err) {
+		LOG_WRN("Failed to send ISO data (err %d)", err);
+		net_buf_unref(buf);
+		return err;
+	}
+
+	if (frame.len > 0) {
+		/* Only this work item takes frames, the peeked one is the
+		 * head of the queue.
+		 */
+		(void)k_msgq_get(&iso_frames, &frame, K_NO_WAIT);
+
+		age_us = k_cyc_to_us_floor32(k_cycle_get_32() - frame.rx_cycles);
+		BRIDGE_STATS_INCN(ble_tx_bytes, frame.len);
+		if (age_us > (CONFIG_BT_NUS_ISO_LATENCY * USEC_PER_MSEC)) {
+			BRIDGE_STATS_INC(iso_late);
+		}
+	}
+
+	atomic_set_bit_to(&carrying, queued++ % ISO_SDUS_IN_FLIGHT, frame.len > 0);
+	atomic_inc(&in_flight);
+
+	return 0;
+}
+
+static void send_work_handler(struct k_work *work)
+{
+	while (atomic_get(&iso_ready) && (atomic_get(&in_flight) < ISO_SDUS_IN_FLIGHT)) {
+		if (iso_sdu_send()) {
+			/* Keep the chain of SDUs going, a slot is not lost
+			 * when the stack is momentarily out of buffers.
+			 */
+			k_work_reschedule(&send_work, K_USEC(CONFIG_BT_NUS_ISO_SDU_INTERVAL));
+			break;
+		}
+	}
+}
+
+int iso_send(const uint8_t *data, size_t len, uint32_t rx_cycles)
+{
+	struct iso_frame frame;
+	uint32_t timestamp_us;
+	int err = 0;
+
+	if (!atomic_get(&iso_ready)) {
+		return -ENOTCONN;
+	}
+
+	timestamp_us = (uint32_t)k_ticks_to_us_floor64(k_uptime_ticks()) -
+		       k_cyc_to_us_floor32(k_cycle_get_32() - rx_cycles);
+
+	for (size_t pos = 0; pos < len; pos += frame.len) {
+		frame.rx_cycles = rx_cycles;
+		frame.timestamp_us = timestamp_us;
+		frame.len = MIN(len - pos, ISO_FRAME_SIZE);
+		memcpy(frame.data, &data[pos], frame.len);
+
+		if (k_msgq_put(&iso_frames, &frame, K_NO_WAIT)) {
+			BRIDGE_STATS_INC(iso_lost);
+			err = -ENOMEM;
+		}
+	}
+
+	return err;
+}
+
+static void iso_connected(struct bt_iso_chan *chan)
+{
+	LOG_INF("ISO channel connected, SDU interval %d us, %d bytes",
+		CONFIG_BT_NUS_ISO_SDU_INTERVAL, CONFIG_BT_NUS_ISO_SDU_SIZE);
+
+	seq_num = 0;
+	queued = 0;
+	completed = 0;
+	atomic_clear(&in_flight);
+	k_msgq_purge(&iso_frames);
+	atomic_set(&iso_ready, 1);
+
+	k_work_reschedule(&send_work, K_NO_WAIT);
+}
+
+static void iso_disconnected(struct bt_iso_chan *chan, uint8_t reason)
+{
+	LOG_INF("ISO channel disconnected (reason 0x%02x)", reason);
+
+	atomic_set(&iso_ready, 0);
+	k_work_cancel_delayable(&send_work);
+}
+
+static void iso_sent(struct bt_iso_chan *chan)
+{
+	/* SDUs are reported sent in the order they were queued. */
+	if (atomic_test_bit(&carrying, completed++ % ISO_SDUS_IN_FLIGHT)) {
+		BRIDGE_STATS_INC(iso_delivered);
+	}
+
+	atomic_dec(&in_flight);
+
+	if (atomic_get(&iso_ready)) {
+		k_work_reschedule(&send_work, K_NO_WAIT);
+	}
+}
+
+#if defined(CONFIG_BT_NUS_ISO_CIS)
+static void iso_recv(struct bt_iso_chan *chan, const struct bt_iso_recv_info *info,
+		     struct net_buf *buf)
+{
+	if (info->flags & BT_ISO_FLAGS_LOST) {
+		BRIDGE_STATS_INC(iso_rx_lost);
+		return;
+	}
+
+	if (!(info->flags & BT_ISO_FLAGS_VALID) || (buf->len == 0)) {
+		return;
+	}
+
+	BRIDGE_STATS_INCN(ble_rx_bytes, buf->len);
+	bridge_uart_write(buf->data, buf->len);
+}
+#endif
+
+static struct bt_iso_chan_ops iso_ops = {
+	.connected = iso_connected,
+	.disconnected = iso_disconnected,
+	.sent = iso_sent,
+#if defined(CONFIG_BT_NUS_ISO_CIS)
+	.recv = iso_recv,
+#endif
+};
+
+static struct bt_iso_chan iso_chan = {
+	.ops = &iso_ops,
+	.qos = &iso_qos,
+};
+
+#if defined(CONFIG_BT_NUS_ISO_CIS)
+static int iso_accept(const struct bt_iso_accept_info *info, struct bt_iso_chan **chan)
+{
+	if (iso_chan.iso) {
+		return -ENOMEM;
+	}
+
+	*chan = &iso_chan;
+
+	return 0;
+}
+
+static struct bt_iso_server iso_server = {
+	.sec_level = BT_SECURITY_L1,
+	.accept = iso_accept,
+};
+
+int iso_init(void)
+{
+	int err;
+
+	/* The central sets the SDU interval and size when it creates the
+	 * CIG, they are expected to match the configured ones.
+	 */
+	err = bt_iso_server_register(&iso_server);
+	if (err) {
+		LOG_ERR("Cannot register ISO server (err %d)", err);
+	}
+
+	return err;
+}
+
+#else /* CONFIG_BT_NUS_ISO_BIS */
+
+static struct bt_le_ext_adv *adv_set;
+static struct bt_iso_big *big;
+static struct bt_iso_chan *bis[] = { &iso_chan };
+
+int iso_init(void)
+{
+	struct bt_iso_big_create_param param = {
+		.num_bis = ARRAY_SIZE(bis),
+		.bis_channels = bis,
+		.interval = CONFIG_BT_NUS_ISO_SDU_INTERVAL,
+		.latency = CONFIG_BT_NUS_ISO_LATENCY,
+		.packing = BT_ISO_PACKING_SEQUENTIAL,
+		.framing = BT_ISO_FRAMING_UNFRAMED,
+	};
+	int err;
+
+	err = bt_le_ext_adv_create(BT_LE_EXT_ADV_NCONN, NULL, &adv_set);
+	if (err) {
+		LOG_ERR("Cannot create BIG advertising set (err %d)", err);
+		return err;
+	}
+
+	err = bt_le_per_adv_set_param(adv_set, BT_LE_PER_ADV_DEFAULT);
+	if (!err) {
+		err = bt_le_per_adv_start(adv_set);
+	}
+
+	if (!err) {
+		err = bt_le_ext_adv_start(adv_set, BT_LE_EXT_ADV_START_DEFAULT);
+	}
+
+	if (err) {
+		LOG_ERR("Cannot start BIG advertising (err %d)", err);
+		return err;
+	}
+
+	err = bt_iso_big_create(adv_set, &param, &big);
+	if (err) {
+		LOG_ERR("Cannot create BIG (err %d)", err);
+	}
+
+	return err;
+}
+
+#endif /* CONFIG_BT_NUS_ISO_CIS */
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef ISO_H_
+#define ISO_H_
+
+/** @file
+ *  @brief Isochronous transport of UART frames
+ *
+ *  Carries the data received from the UART in the SDUs of a Connected
+ *  Isochronous Stream set up by the central, or of a Broadcast Isochronous
+ *  Stream, one SDU per SDU interval.
+ */
+
+#include <stddef.h>
+#include <zephyr/types.h>
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** SDU header, little-endian, followed by the frame data. */
+struct iso_sdu_hdr {
+	/** Time at which the first byte of the frame was received from the
+	 *  UART, in microseconds of the bridge uptime.
+	 */
+	uint32_t timestamp_us;
+	/** Length of the frame data, 0 if the SDU carries no data. */
+	uint16_t len;
+} __packed;
+
+/** Largest frame data carried by one SDU. */
+#define ISO_FRAME_SIZE (CONFIG_BT_NUS_ISO_SDU_SIZE - sizeof(struct iso_sdu_hdr))
+
+#if defined(CONFIG_BT_NUS_ISO)
+
+/** @brief Start the isochronous transport.
+ *
+ *  With a Connected Isochronous Stream, registers the server accepting the
+ *  stream from the central. With a Broadcast Isochronous Stream, starts the
+ *  broadcast.
+ *
+ *  @return 0 on success, negative error code otherwise.
+ */
+int iso_init(void);
+
+/** @brief Queue UART data for isochronous transmission.
+ *
+ *  The data is split into frames of up to ISO_FRAME_SIZE bytes, each sent
+ *  in its own SDU.
+ *
+ *  @param data      Data to send.
+ *  @param len       Data length.
+ *  @param rx_cycles Hardware cycle count at which the first byte was
+ *                   received from the UART.
+ *
+ *  @retval 0 on success.
+ *  @retval -ENOTCONN if the stream is not established.
+ *  @retval -ENOMEM if some frames were dropped.
+ */
+int iso_send(const uint8_t *data, size_t len, uint32_t rx_cycles);
+
+#else
+
+static inline int iso_init(void)
+{
+	return 0;
+}
+
+static inline int iso_send(const uint8_t *data, size_t len, uint32_t rx_cycles)
+{
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+	ARG_UNUSED(rx_cycles);
+
+	return -ENOTCONN;
+}
+
+#endif /* CONFIG_BT_NUS_ISO */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ISO_H_ */
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/sys/atomic.h>
+
+#include <zephyr/logging/log.h>
+
+#include "bridge_stats.h"
+#include "link_pm.h"
+
+LOG_MODULE_DECLARE(peripheral_uart);
+
+/* Longest supervision timeout, in 10 ms units. */
+#define TIMEOUT_MAX 3200
+
+BUILD_ASSERT(CONFIG_BT_NUS_LINK_PM_CONTINUATION < CONFIG_BT_NUS_LINK_PM_SUBRATE,
+	     "The continuation number must be lower than the subrate factor");
+
+enum link_pm_flag {
+	/* Connection events are skipped. */
+	LINK_PM_IDLE,
+	/* The full rate was requested after activity on the idle link. */
+	LINK_PM_WAKING,
+};
+
+static atomic_t flags;
+static struct bt_conn *conn;
+static struct k_work_delayable idle_work;
+static struct k_work wake_work;
+
+/* Cycle count of the first activity on the idle link. */
+static uint32_t wake_cycles;
+/* Connection subrating is tried until the local or peer controller
+ * turns out not to support it.
+ */
+static bool subrating;
+/* Connection interval in 1.25 ms units and supervision timeout in 10 ms
+ * units at the full rate.
+ */
+static uint16_t interval;
+static uint16_t timeout;
+
+/* The supervision timeout must exceed twice the time between the
+ * connection events the peripheral listens to.
+ */
+static uint16_t supervision_timeout(uint16_t skip)
+{
+	uint32_t min = (BT_CONN_INTERVAL_TO_US(interval) * skip * 2) / (10 * USEC_PER_MSEC) + 1;
+
+	return CLAMP(min, timeout, TIMEOUT_MAX);
+}
+
+static void events_report(uint16_t conn_interval, uint16_t skip)
+{
+	BRIDGE_STATS_SET(lpm_events_ps,
+			 USEC_PER_SEC / (BT_CONN_INTERVAL_TO_US(conn_interval) * skip));
+}
+
+static int rate_set(bool idle)
+{
+	uint16_t latency = idle ? CONFIG_BT_NUS_LINK_PM_LATENCY : 0;
+	struct bt_le_conn_param param = {
+		.interval_min = interval,
+		.interval_max = interval,
+		.latency = latency,
+		.timeout = supervision_timeout(latency + 1),
+	};
+
+#if defined(CONFIG_BT_SUBRATING)
+	if (subrating) {
+		uint16_t factor = idle ? CONFIG_BT_NUS_LINK_PM_SUBRATE : 1;
+		const struct bt_conn_le_subrate_param subrate = {
+			.subrate_min = factor,
+			.subrate_max = factor,
+			.max_latency = 0,
+			.continuation_number = idle ? CONFIG_BT_NUS_LINK_PM_CONTINUATION : 0,
+			.supervision_timeout = supervision_timeout(factor),
+		};
+		int err;
+
+		err = bt_conn_le_subrate_request(conn, &subrate);
+		if (err != -ENOTSUP) {
+			return err;
+		}
+
+		LOG_INF("Connection subrating not supported, using peripheral latency");
+		subrating = false;
+	}
+#endif
+
+	return bt_conn_le_param_update(conn, &param);
+}
+
+static void wake_done(void)
+{
+	uint32_t lat_us;
+
+	if (!atomic_test_and_clear_bit(&flags, LINK_PM_WAKING)) {
+		return;
+	}
+
+	/* Time the first data waited for the full rate, at most one reduced
+	 * rate period for the request to reach the peer and the update
+	 * instant.
+	 */
+	lat_us = k_cyc_to_us_floor32(k_cycle_get_32() - wake_cycles);
+
+	BRIDGE_STATS_SET(lpm_wake_lat_us, lat_us);
+	BRIDGE_STATS_SET(lpm_wake_lat_max_us, MAX(bridge_stats.lpm_wake_lat_max_us, lat_us));
+
+	LOG_DBG("Full connection event rate %u us after activity", lat_us);
+}
+
+static void idle_work_handler(struct k_work *work)
+{
+	int err;
+
+	if (!conn || atomic_test_and_set_bit(&flags, LINK_PM_IDLE)) {
+		return;
+	}
+
+	/* Activity from now on restores the full rate after this request. */
+	err = rate_set(true);
+	if (err) {
+		LOG_WRN("Cannot reduce the connection event rate (err %d)", err);
+		atomic_clear_bit(&flags, LINK_PM_IDLE);
+		return;
+	}
+
+	BRIDGE_STATS_INC(lpm_idle);
+}
+
+static void wake_work_handler(struct k_work *work)
+{
+	int err;
+
+	if (!conn) {
+		return;
+	}
+
+	err = rate_set(false);
+	if (err) {
+		LOG_WRN("Cannot restore the connection event rate (err %d)", err);
+		atomic_clear_bit(&flags, LINK_PM_WAKING);
+		return;
+	}
+
+	BRIDGE_STATS_INC(lpm_wakeups);
+}
+
+void link_pm_activity(void)
+{
+	if (!conn) {
+		return;
+	}
+
+	k_work_reschedule(&idle_work, K_MSEC(CONFIG_BT_NUS_LINK_PM_IDLE_TIME));
+
+	if (atomic_test_and_clear_bit(&flags, LINK_PM_IDLE)) {
+		wake_cycles = k_cycle_get_32();
+		atomic_set_bit(&flags, LINK_PM_WAKING);
+		k_work_submit(&wake_work);
+	}
+}
+
+static void connected(struct bt_conn *new_conn, uint8_t err)
+{
+	struct bt_conn_info info;
+
+	if (err || conn || bt_conn_get_info(new_conn, &info) ||
+	    (info.role != BT_CONN_ROLE_PERIPHERAL)) {
+		return;
+	}
+
+	conn = bt_conn_ref(new_conn);
+	interval = info.le.interval;
+	timeout = info.le.timeout;
+	subrating = IS_ENABLED(CONFIG_BT_SUBRATING);
+	atomic_clear(&flags);
+
+	events_report(interval, 1);
+	k_work_reschedule(&idle_work, K_MSEC(CONFIG_BT_NUS_LINK_PM_IDLE_TIME));
+}
+
+static void disconnected(struct bt_conn *old_conn, uint8_t reason)
+{
+	if (old_conn != conn) {
+		return;
+	}
+
+	bt_conn_unref(conn);
+	conn = NULL;
+
+	k_work_cancel_delayable(&idle_work);
+	atomic_clear(&flags);
+}
+
+static void le_param_updated(struct bt_conn *updated_conn, uint16_t new_interval,
+			     uint16_t latency, uint16_t new_timeout)
+{
+	if (updated_conn != conn) {
+		return;
+	}
+
+	interval = new_interval;
+
+	if (latency == 0) {
+		timeout = new_timeout;
+		wake_done();
+	}
+
+	events_report(new_interval, latency + 1);
+}
+
+#if defined(CONFIG_BT_SUBRATING)
+static void subrate_changed(struct bt_conn *updated_conn,
+			    const struct bt_conn_le_subrate_changed *params)
+{
+	if (updated_conn != conn) {
+		return;
+	}
+
+	if (params->status) {
+		/* Most likely not supported by the peer. */
+		LOG_INF("Subrate request failed (status 0x%02x), using peripheral latency",
+			params->status);
+		subrating = false;
+
+		if (atomic_test_bit(&flags, LINK_PM_WAKING)) {
+			k_work_submit(&wake_work);
+		} else if (atomic_test_and_clear_bit(&flags, LINK_PM_IDLE)) {
+			k_work_reschedule(&idle_work, K_NO_WAIT);
+		}
+
+		return;
+	}
+
+	if (params->factor == 1) {
+		wake_done();
+	}
+
+	events_report(interval, params->factor * (params->peripheral_latency + 1));
+}
+#endif
+
+BT_CONN_CB_DEFINE(link_pm_conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+	.le_param_updated = le_param_updated,
+#if defined(CONFIG_BT_SUBRATING)
+	.subrate_changed = subrate_changed,
+#endif
+};
+
+static int link_pm_sys_init(void)
+{
+	k_work_init_delayable(&idle_work, idle_work_handler);
+	k_work_init(&wake_work, wake_work_handler);
+
+	return 0;
+}
+
+SYS_INIT(link_pm_sys_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef LINK_PM_H_
+#define LINK_PM_H_
+
+/** @file
+ *  @brief Connection power manager
+ *
+ *  Lets the peripheral skip connection events while no data flows, with
+ *  connection subrating when both controllers support it and peripheral
+ *  latency otherwise, and restores the full connection event rate as soon
+ *  as data shows up again.
+ */
+
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CONFIG_BT_NUS_LINK_PM)
+
+/** @brief Account data moving through the bridge.
+ *
+ *  Restores the full connection event rate if the link is idle. Can be
+ *  called from interrupt context.
+ */
+void link_pm_activity(void);
+
+#else
+
+static inline void link_pm_activity(void) {}
+
+#endif /* CONFIG_BT_NUS_LINK_PM */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LINK_PM_H_ */
@@ -13,11 +13,16 @@
 
 #include <zephyr/types.h>
 #include <zephyr/kernel.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/pwm.h>
 #include <zephyr/drivers/uart.h>
+#include <zephyr/pm/device.h>
+#include <zephyr/timing/timing.h>
 #include <zephyr/usb/usb_device.h>
 
 #include <zephyr/device.h>
 #include <zephyr/devicetree.h>
+#include <zephyr/linker/linker-defs.h>
 #include <soc.h>
 
 #include <zephyr/bluetooth/bluetooth.h>
@@ -31,9 +36,27 @@
 
 #include <zephyr/settings/settings.h>
 
-#include <stdio.h>
 #include <string.h>
 
+#include "batch_ctrl.h"
+#include "bridge.h"
+#include "bridge_stats.h"
+#include "broadcast.h"
+#include "buf_track.h"
+#include "conn_evt.h"
+#include "event_ring.h"
+#include "gateway.h"
+#include "health.h"
+#include "iso.h"
+#include "link_pm.h"
+#include "phy_mgr.h"
+#include "qos.h"
+#include "relay.h"
+#include "reliable.h"
+#include "settings_sched.h"
+#include "uart_buf.h"
+#include "uart_chan.h"
+
 #include <zephyr/logging/log.h>
 
 #define LOG_MODULE_NAME peripheral_uart
@@ -47,33 +70,247 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 #define RUN_STATUS_LED DK_LED1
 #define RUN_LED_BLINK_INTERVAL 1000
+/* Duty cycle divider of the run status LED driven by PWM. */
+#define RUN_LED_PWM_DIM 10
 
 #define CON_STATUS_LED DK_LED2
 
 #define KEY_PASSKEY_ACCEPT DK_BTN1_MSK
 #define KEY_PASSKEY_REJECT DK_BTN2_MSK
 
-#define UART_BUF_SIZE CONFIG_BT_NUS_UART_BUFFER_SIZE
+#define UART_WELCOME "Starting Nordic UART service sample\r\n"
+BUILD_ASSERT(sizeof(UART_WELCOME) - 1 <= UART_BUF_SIZE,
+	     "The UART buffers must hold the welcome message");
 #define UART_WAIT_FOR_BUF_DELAY K_MSEC(50)
+#if defined(CONFIG_BT_NUS_DEADLINE)
+/* Report idle reception early enough for the data to meet its deadline. */
+#define UART_WAIT_FOR_RX MIN(CONFIG_BT_NUS_UART_RX_WAIT_TIME, \
+			     CONFIG_BT_NUS_DEADLINE_MS * USEC_PER_MSEC / 4)
+/* Hold time of the oldest byte of a batch, leaving the margin to send it. */
+#define DEADLINE_HOLD_MS (CONFIG_BT_NUS_DEADLINE_MS - CONFIG_BT_NUS_DEADLINE_MARGIN_MS)
+BUILD_ASSERT(CONFIG_BT_NUS_DEADLINE_MS > CONFIG_BT_NUS_DEADLINE_MARGIN_MS,
+	     "The flush margin must be shorter than the deadline");
+#else
 #define UART_WAIT_FOR_RX CONFIG_BT_NUS_UART_RX_WAIT_TIME
+#define DEADLINE_HOLD_MS SYS_FOREVER_MS
+#endif
+
+#if defined(CONFIG_BT_NUS_BATCH_ADAPTIVE)
+#define NUS_BATCH_SIZE CONFIG_BT_NUS_BATCH_BUFFER_SIZE
+#else
+#define NUS_BATCH_SIZE UART_BUF_SIZE
+#endif
+
+/* Header in front of the data of each notification. */
+#if defined(CONFIG_BT_NUS_UART_CHANNELS)
+#define NUS_HDR_SIZE sizeof(struct uart_chan_hdr)
+#elif defined(CONFIG_BT_NUS_RELIABLE)
+#define NUS_HDR_SIZE sizeof(struct reliable_data_hdr)
+#elif defined(CONFIG_BT_NUS_RELAY_TRACE)
+#define NUS_HDR_SIZE sizeof(struct relay_trace_hdr)
+#else
+#define NUS_HDR_SIZE 0
+#endif
 
 static K_SEM_DEFINE(ble_init_ok, 0, 1);
 
 static struct bt_conn *current_conn;
 static struct bt_conn *auth_conn;
 static struct k_work adv_work;
+/* The connection runs on the Coded PHY. */
+static bool conn_coded;
 
 static const struct device *uart = DEVICE_DT_GET(DT_CHOSEN(nordic_nus_uart));
 static struct k_work_delayable uart_work;
 
-struct uart_data_t {
-	void *fifo_reserved;
-	uint8_t data[UART_BUF_SIZE];
+/* UART data aggregated into a single notification. */
+struct nus_batch {
+#if defined(CONFIG_BT_NUS_UART_CHANNELS)
+	/* Sent along with the data that follows it. */
+	struct uart_chan_hdr hdr;
+#elif defined(CONFIG_BT_NUS_RELAY_TRACE)
+	struct relay_trace_hdr trace;
+#endif
+	uint8_t data[NUS_BATCH_SIZE];
 	uint16_t len;
+	/* Cycle count at which the oldest byte was received. */
+	uint32_t timestamp;
 };
 
-static K_FIFO_DEFINE(fifo_uart_tx_data);
 static K_FIFO_DEFINE(fifo_uart_rx_data);
+#if defined(CONFIG_BT_NUS_LANES)
+static K_FIFO_DEFINE(fifo_uart_rx_prio);
+#endif
+
+#if defined(CONFIG_BT_NUS_LANES)
+/* Lane of the line being received, carried over to the next buffer until
+ * the line ends, so that a message is never split across lanes.
+ */
+static bool lane_line_open;
+static bool lane_line_prio;
+
+static bool lane_is_eol(uint8_t byte)
+{
+	return (byte == '\n') || (byte == '\r');
+}
+
+/* Length of the line starting at data, up to and including its end of line,
+ * or of the whole data if the line continues in the next buffer.
+ */
+static size_t lane_line_len(const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		if (lane_is_eol(data[i])) {
+			return i + 1;
+		}
+	}
+
+	return len;
+}
+
+static bool lane_line_is_prio(const uint8_t *line, size_t len, bool complete)
+{
+	static const char prefixes[] = CONFIG_BT_NUS_LANES_PREFIXES;
+
+	if (complete && (len <= CONFIG_BT_NUS_LANES_SHORT_LEN)) {
+		return true;
+	}
+
+	return memchr(prefixes, line[0], sizeof(prefixes) - 1) != NULL;
+}
+
+/* Classify the lines at the start of the buffer, return the length of the
+ * run of lines of the same lane.
+ */
+static size_t lane_run_len(const struct uart_data_t *buf, bool *prio)
+{
+	size_t pos = 0;
+
+	while (pos < buf->len) {
+		size_t len = lane_line_len(&buf->data[pos], buf->len - pos);
+		bool complete = lane_is_eol(buf->data[pos + len - 1]);
+		/* The "\n" of a "\r\n" end of line stays with its line. */
+		bool line_prio = (lane_line_open || (len == 1 && complete)) ? lane_line_prio :
+				 lane_line_is_prio(&buf->data[pos], len, complete);
+
+		if ((pos > 0) && (line_prio != *prio)) {
+			break;
+		}
+
+		*prio = line_prio;
+		lane_line_open = !complete;
+		lane_line_prio = line_prio;
+		pos += len;
+	}
+
+	return pos;
+}
+#endif /* CONFIG_BT_NUS_LANES */
+
+/* Queue received data, splitting it at the boundaries between lines of
+ * different lanes.
+ */
+static void uart_rx_queue(struct uart_data_t *buf)
+{
+#if defined(CONFIG_BT_NUS_LANES)
+	while (buf) {
+		struct uart_data_t *tail = NULL;
+		size_t len = lane_run_len(buf, &buf->prio);
+
+		if (len < buf->len) {
+			tail = uart_buf_alloc();
+			if (tail) {
+				tail->len = buf->len - len;
+				tail->timestamp = buf->timestamp;
+				memcpy(tail->data, &buf->data[len], tail->len);
+				buf->len = len;
+			} else {
+				/* Keep the whole buffer in the low priority
+				 * lane, along with the rest of its last line.
+				 */
+				BRIDGE_STATS_INC(lane_split_fail);
+				buf->prio = false;
+				lane_line_open = !lane_is_eol(buf->data[buf->len - 1]);
+				lane_line_prio = false;
+			}
+		}
+
+		bridge_stats_queue_put(BRIDGE_QUEUE_UART_RX);
+		UART_BUF_OWNER(buf, BUF_OWNER_RX_QUEUE);
+		k_fifo_put(buf->prio ? &fifo_uart_rx_prio : &fifo_uart_rx_data, buf);
+
+		buf = tail;
+	}
+#else
+	bridge_stats_queue_put(BRIDGE_QUEUE_UART_RX);
+	UART_BUF_OWNER(buf, BUF_OWNER_RX_QUEUE);
+	k_fifo_put(&fifo_uart_rx_data, buf);
+#endif
+}
+
+#if defined(CONFIG_BT_NUS_DEADLINE)
+/* Hand over the bytes received so far without stopping the reception,
+ * which keeps receiving into the same buffer.
+ */
+static void uart_rx_hand_over(struct uart_data_t *buf)
+{
+	struct uart_data_t *copy = uart_buf_alloc();
+
+	if (!copy) {
+		/* Handed over along with the rest of the buffer once it is
+		 * released.
+		 */
+		BRIDGE_STATS_INC(uart_rx_buf_fail);
+		return;
+	}
+
+	copy->len = buf->len - buf->handed;
+	copy->timestamp = buf->timestamp;
+	memcpy(copy->data, &buf->data[buf->handed], copy->len);
+	uart_rx_queue(copy);
+
+	/* The next bytes are received after this point. */
+	buf->handed = buf->len;
+	buf->timestamp = k_cycle_get_32();
+}
+
+/* Queue what was not handed over yet of a released receive buffer. */
+static void uart_rx_release(struct uart_data_t *buf)
+{
+	if (buf->handed >= buf->len) {
+		uart_buf_free(buf);
+		return;
+	}
+
+	if (buf->handed > 0) {
+		buf->len -= buf->handed;
+		memmove(buf->data, &buf->data[buf->handed], buf->len);
+		buf->handed = 0;
+	}
+
+	uart_rx_queue(buf);
+}
+#else
+static void uart_rx_release(struct uart_data_t *buf)
+{
+	if (buf->len > 0) {
+		uart_rx_queue(buf);
+	} else {
+		uart_buf_free(buf);
+	}
+}
+#endif /* CONFIG_BT_NUS_DEADLINE */
+
+/* Restart reception once a receive buffer can be allocated. */
+static void uart_rx_wait_for_buf(void)
+{
+#if defined(CONFIG_BT_NUS_LOW_WAKE)
+	/* Restarted when the next buffer is released. */
+	uart_buf_wait(&uart_work);
+#else
+	k_work_reschedule(&uart_work, UART_WAIT_FOR_BUF_DELAY);
+#endif
+}
 
 static const struct bt_data ad[] = {
 	BT_DATA_BYTES(BT_DATA_FLAGS, (BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR)),
@@ -84,95 +321,361 @@ static const struct bt_data sd[] = {
 	BT_DATA_BYTES(BT_DATA_UUID128_ALL, BT_UUID_NUS_VAL),
 };
 
+#if defined(CONFIG_BT_NUS_LONG_RANGE)
+/* Connectable extended advertising cannot be scannable, so the service UUID
+ * is advertised along with the name.
+ */
+static const struct bt_data ad_ext[] = {
+	BT_DATA_BYTES(BT_DATA_FLAGS, (BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR)),
+	BT_DATA(BT_DATA_NAME_COMPLETE, DEVICE_NAME, DEVICE_NAME_LEN),
+	BT_DATA_BYTES(BT_DATA_UUID128_ALL, BT_UUID_NUS_VAL),
+};
+
+static struct bt_le_ext_adv *adv_set;
+#endif /* CONFIG_BT_NUS_LONG_RANGE */
+
 #ifdef CONFIG_UART_ASYNC_ADAPTER
 UART_ASYNC_ADAPTER_INST_DEFINE(async_adapter);
 #else
 #define async_adapter NULL
 #endif
 
-static void uart_cb(const struct device *dev, struct uart_event *evt, void *user_data)
+/* State of the UART pipeline, observed by the health monitor. */
+static struct {
+	/* Buffers owned by the driver for reception. */
+	atomic_t rx_bufs;
+	bool rx_enabled;
+	/* Uptime at which reception was disabled and why it was not
+	 * enabled again.
+	 */
+	int64_t rx_disabled_at;
+	int rx_err;
+	uint32_t baudrate;
+	/* The receiver can hold the transmission back through CTS. */
+	bool flow_ctrl;
+} uart_state;
+
+static int uart_rx_start(struct uart_data_t *buf)
 {
-	ARG_UNUSED(dev);
+	int err;
+
+	err = uart_rx_enable(uart, buf->data, sizeof(buf->data), UART_WAIT_FOR_RX);
+	if (err) {
+		uart_state.rx_err = err;
+		return err;
+	}
+
+	atomic_inc(&uart_state.rx_bufs);
+	uart_state.rx_enabled = true;
+	UART_BUF_OWNER(buf, BUF_OWNER_UART_RX);
+
+	return 0;
+}
+
+#if defined(CONFIG_BT_NUS_UART_LP)
+BUILD_ASSERT(DT_NODE_HAS_PROP(DT_PATH(zephyr_user), nus_uart_wake_gpios),
+	     "The UART wake-up line is taken from the nus-uart-wake-gpios property");
 
-	static size_t aborted_len;
+/* Longest time for reception to stop before the UART is suspended. */
+#define UART_LP_RX_OFF_TIMEOUT K_MSEC(100)
+
+enum uart_lp_state {
+	UART_LP_ACTIVE,
+	UART_LP_SUSPENDING,
+	UART_LP_SUSPENDED,
+};
+
+/* RX line of the UART, sensed for the start bit of the first byte while
+ * the UART is suspended.
+ */
+static const struct gpio_dt_spec uart_wake =
+	GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), nus_uart_wake_gpios);
+static struct gpio_callback uart_wake_cb;
+
+static K_MUTEX_DEFINE(uart_lp_lock);
+static K_SEM_DEFINE(uart_lp_rx_off, 0, 1);
+static struct k_work_delayable uart_lp_idle_work;
+static struct k_work uart_lp_wake_work;
+static atomic_t uart_lp_state;
+static uint32_t uart_lp_edge_cycles;
+static int64_t uart_lp_suspended_at;
+
+static void uart_lp_activity(void)
+{
+	k_work_reschedule(&uart_lp_idle_work, K_MSEC(CONFIG_BT_NUS_UART_LP_IDLE_TIME));
+}
+
+static bool uart_lp_suspended(void)
+{
+	return atomic_get(&uart_lp_state) != UART_LP_ACTIVE;
+}
+
+/* Return true if reception must stay disabled. */
+static bool uart_lp_rx_disabled(void)
+{
+	if (!uart_lp_suspended()) {
+		return false;
+	}
+
+	k_sem_give(&uart_lp_rx_off);
+
+	return true;
+}
+
+static void uart_lp_idle_work_handler(struct k_work *work)
+{
+	int err;
+
+	k_mutex_lock(&uart_lp_lock, K_FOREVER);
+
+	if (uart_lp_suspended()) {
+		goto out;
+	}
+
+	if (uart_tx_busy()) {
+		uart_lp_activity();
+		goto out;
+	}
+
+	atomic_set(&uart_lp_state, UART_LP_SUSPENDING);
+	k_sem_reset(&uart_lp_rx_off);
+
+	/* -EFAULT if reception was already disabled. */
+	err = uart_rx_disable(uart);
+	if (!err) {
+		err = k_sem_take(&uart_lp_rx_off, UART_LP_RX_OFF_TIMEOUT);
+	} else if (err == -EFAULT) {
+		err = 0;
+	}
+
+	if (!err) {
+		err = pm_device_action_run(uart, PM_DEVICE_ACTION_SUSPEND);
+	}
+
+	/* The suspension applies the sleep state of the UART pins, whose
+	 * low-power-enable disconnects the input buffer of the RX pin.
+	 */
+	if (!err) {
+		err = gpio_pin_configure_dt(&uart_wake, GPIO_INPUT);
+	}
+
+	if (!err) {
+		err = gpio_pin_interrupt_configure_dt(&uart_wake, GPIO_INT_LEVEL_ACTIVE);
+	}
+
+	if (err) {
+		LOG_WRN("Cannot suspend the UART (err %d)", err);
+		(void)pm_device_action_run(uart, PM_DEVICE_ACTION_RESUME);
+		atomic_set(&uart_lp_state, UART_LP_ACTIVE);
+		k_work_reschedule(&uart_work, K_NO_WAIT);
+		goto out;
+	}
+
+	atomic_set(&uart_lp_state, UART_LP_SUSPENDED);
+	uart_lp_suspended_at = k_uptime_get();
+	BRIDGE_STATS_INC(ulp_suspends);
+
+out:
+	k_mutex_unlock(&uart_lp_lock);
+}
+
+/* Resume the UART and restart reception, return true if it was suspended. */
+static bool uart_lp_wake(void)
+{
 	struct uart_data_t *buf;
-	static uint8_t *aborted_buf;
-	static bool disable_req;
+	int err;
 
-	switch (evt->type) {
-	case UART_TX_DONE:
-		LOG_DBG("UART_TX_DONE");
-		if ((evt->data.tx.len == 0) ||
-		    (!evt->data.tx.buf)) {
-			return;
-		}
+	if (!uart_lp_suspended()) {
+		return false;
+	}
 
-		if (aborted_buf) {
-			buf = CONTAINER_OF(aborted_buf, struct uart_data_t,
-					   data[0]);
-			aborted_buf = NULL;
-			aborted_len = 0;
-		} else {
-			buf = CONTAINER_OF(evt->data.tx.buf, struct uart_data_t,
-					   data[0]);
-		}
+	k_mutex_lock(&uart_lp_lock, K_FOREVER);
 
-		k_free(buf);
+	if (atomic_get(&uart_lp_state) != UART_LP_SUSPENDED) {
+		k_mutex_unlock(&uart_lp_lock);
+		return false;
+	}
 
-		buf = k_fifo_get(&fifo_uart_tx_data, K_NO_WAIT);
-		if (!buf) {
-			return;
-		}
+	(void)gpio_pin_interrupt_configure_dt(&uart_wake, GPIO_INT_DISABLE);
 
-		if (uart_tx(uart, buf->data, buf->len, SYS_FOREVER_MS)) {
-			LOG_WRN("Failed to send data over UART");
-		}
+	err = pm_device_action_run(uart, PM_DEVICE_ACTION_RESUME);
+	if (err) {
+		LOG_WRN("Cannot resume the UART (err %d)", err);
+	}
+
+	atomic_set(&uart_lp_state, UART_LP_ACTIVE);
+	BRIDGE_STATS_INCN(ulp_suspended_ms, k_uptime_get() - uart_lp_suspended_at);
+
+	buf = uart_buf_alloc();
+	if (!buf) {
+		uart_rx_wait_for_buf();
+	} else if (uart_rx_start(buf)) {
+		uart_buf_free(buf);
+		k_work_reschedule(&uart_work, UART_WAIT_FOR_BUF_DELAY);
+	}
+
+	uart_lp_activity();
+
+	k_mutex_unlock(&uart_lp_lock);
+
+	return true;
+}
+
+static void uart_lp_wake_work_handler(struct k_work *work)
+{
+	uint32_t lat_us;
 
+	if (!uart_lp_wake()) {
+		return;
+	}
+
+	/* Bytes received meanwhile are lost, see the README. */
+	lat_us = k_cyc_to_us_floor32(k_cycle_get_32() - uart_lp_edge_cycles);
+
+	BRIDGE_STATS_SET(ulp_wake_us, lat_us);
+	BRIDGE_STATS_SET(ulp_wake_max_us, MAX(bridge_stats.ulp_wake_max_us, lat_us));
+}
+
+static void uart_wake_handler(const struct device *port, struct gpio_callback *cb,
+			      gpio_port_pins_t pins)
+{
+	(void)gpio_pin_interrupt_configure_dt(&uart_wake, GPIO_INT_DISABLE);
+
+	uart_lp_edge_cycles = k_cycle_get_32();
+	k_work_submit(&uart_lp_wake_work);
+}
+
+static int uart_lp_init(void)
+{
+	int err;
+
+	if (!gpio_is_ready_dt(&uart_wake)) {
+		return -ENODEV;
+	}
+
+	err = gpio_pin_configure_dt(&uart_wake, GPIO_INPUT);
+	if (err) {
+		return err;
+	}
+
+	gpio_init_callback(&uart_wake_cb, uart_wake_handler, BIT(uart_wake.pin));
+
+	err = gpio_add_callback_dt(&uart_wake, &uart_wake_cb);
+	if (err) {
+		return err;
+	}
+
+	k_work_init_delayable(&uart_lp_idle_work, uart_lp_idle_work_handler);
+	k_work_init(&uart_lp_wake_work, uart_lp_wake_work_handler);
+	uart_lp_activity();
+
+	return 0;
+}
+#else
+static void uart_lp_activity(void) {}
+
+static bool uart_lp_suspended(void)
+{
+	return false;
+}
+
+static bool uart_lp_rx_disabled(void)
+{
+	return false;
+}
+
+static bool uart_lp_wake(void)
+{
+	return false;
+}
+#endif /* CONFIG_BT_NUS_UART_LP */
+
+static HOT_PATH void uart_cb(const struct device *dev, struct uart_event *evt, void *user_data)
+{
+	ARG_UNUSED(dev);
+
+	int err;
+	struct uart_data_t *buf;
+	static bool disable_req;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+		LOG_DBG("UART_TX_DONE");
+		uart_tx_event(evt);
 		break;
 
 	case UART_RX_RDY:
 		LOG_DBG("UART_RX_RDY");
 		buf = CONTAINER_OF(evt->data.rx.buf, struct uart_data_t, data[0]);
+		if (buf->len == 0) {
+			buf->timestamp = k_cycle_get_32();
+			link_pm_activity();
+		}
 		buf->len += evt->data.rx.len;
+		BRIDGE_STATS_INCN(uart_rx_bytes, evt->data.rx.len);
+		uart_lp_activity();
 
 		if (disable_req) {
 			return;
 		}
 
+#if defined(CONFIG_BT_NUS_DEADLINE)
+		/* Hand over the data received before the line went idle
+		 * instead of waiting for the buffer to fill. Disabling the
+		 * reception for it would lose the bytes arriving meanwhile.
+		 */
+		uart_rx_hand_over(buf);
+#else
 		if ((evt->data.rx.buf[buf->len - 1] == '\n') ||
 		    (evt->data.rx.buf[buf->len - 1] == '\r')) {
 			disable_req = true;
 			uart_rx_disable(uart);
 		}
+#endif
 
 		break;
 
 	case UART_RX_DISABLED:
 		LOG_DBG("UART_RX_DISABLED");
 		disable_req = false;
+		uart_state.rx_enabled = false;
+		uart_state.rx_disabled_at = k_uptime_get();
 
-		buf = k_malloc(sizeof(*buf));
-		if (buf) {
-			buf->len = 0;
-		} else {
+		if (uart_lp_rx_disabled()) {
+			break;
+		}
+
+		buf = uart_buf_alloc();
+		if (!buf) {
 			LOG_WRN("Not able to allocate UART receive buffer");
-			k_work_reschedule(&uart_work, UART_WAIT_FOR_BUF_DELAY);
+			BRIDGE_STATS_INC(uart_rx_buf_fail);
+			uart_state.rx_err = -ENOMEM;
+			uart_rx_wait_for_buf();
 			return;
 		}
 
-		uart_rx_enable(uart, buf->data, sizeof(buf->data),
-			       UART_WAIT_FOR_RX);
+		err = uart_rx_start(buf);
+		event_ring_log(EVENT_UART_RX_RESTART, 0, err);
+		if (err) {
+			uart_buf_free(buf);
+			k_work_reschedule(&uart_work, UART_WAIT_FOR_BUF_DELAY);
+		}
 
 		break;
 
 	case UART_RX_BUF_REQUEST:
 		LOG_DBG("UART_RX_BUF_REQUEST");
-		buf = k_malloc(sizeof(*buf));
+		buf = uart_buf_alloc();
 		if (buf) {
-			buf->len = 0;
-			uart_rx_buf_rsp(uart, buf->data, sizeof(buf->data));
+			if (uart_rx_buf_rsp(uart, buf->data, sizeof(buf->data))) {
+				uart_buf_free(buf);
+			} else {
+				atomic_inc(&uart_state.rx_bufs);
+				UART_BUF_OWNER(buf, BUF_OWNER_UART_RX);
+			}
 		} else {
 			LOG_WRN("Not able to allocate UART receive buffer");
+			BRIDGE_STATS_INC(uart_rx_buf_fail);
 		}
 
 		break;
@@ -181,28 +684,14 @@ static void uart_cb(const struct device *dev, struct uart_event *evt, void *user
 		LOG_DBG("UART_RX_BUF_RELEASED");
 		buf = CONTAINER_OF(evt->data.rx_buf.buf, struct uart_data_t,
 				   data[0]);
-
-		if (buf->len > 0) {
-			k_fifo_put(&fifo_uart_rx_data, buf);
-		} else {
-			k_free(buf);
-		}
+		atomic_dec(&uart_state.rx_bufs);
+		uart_rx_release(buf);
 
 		break;
 
 	case UART_TX_ABORTED:
 		LOG_DBG("UART_TX_ABORTED");
-		if (!aborted_buf) {
-			aborted_buf = (uint8_t *)evt->data.tx.buf;
-		}
-
-		aborted_len += evt->data.tx.len;
-		buf = CONTAINER_OF((void *)aborted_buf, struct uart_data_t,
-				   data);
-
-		uart_tx(uart, &buf->data[aborted_len],
-			buf->len - aborted_len, SYS_FOREVER_MS);
-
+		uart_tx_event(evt);
 		break;
 
 	default:
@@ -210,22 +699,199 @@ static void uart_cb(const struct device *dev, struct uart_event *evt, void *user
 	}
 }
 
+#if defined(CONFIG_BT_NUS_HOT_PATH_CYCLES)
+/* Moving average of the time spent in a hot path function. */
+static uint32_t hot_path_ns(timing_t start, uint32_t avg_ns)
+{
+	timing_t end = timing_counter_get();
+	uint32_t ns = (uint32_t)timing_cycles_to_ns(timing_cycles_get(&start, &end));
+
+	return avg_ns ? ((7 * avg_ns + ns) / 8) : ns;
+}
+
+static void uart_cb_timed(const struct device *dev, struct uart_event *evt, void *user_data)
+{
+	timing_t start = timing_counter_get();
+	bool rx_rdy = (evt->type == UART_RX_RDY);
+
+	uart_cb(dev, evt, user_data);
+
+	if (rx_rdy) {
+		BRIDGE_STATS_SET(hp_uart_cb_ns, hot_path_ns(start, bridge_stats.hp_uart_cb_ns));
+	}
+}
+#define UART_CB uart_cb_timed
+#else
+#define UART_CB uart_cb
+#endif /* CONFIG_BT_NUS_HOT_PATH_CYCLES */
+
 static void uart_work_handler(struct k_work *item)
 {
+	int err;
 	struct uart_data_t *buf;
 
-	buf = k_malloc(sizeof(*buf));
-	if (buf) {
-		buf->len = 0;
-	} else {
+	if (uart_lp_suspended()) {
+		/* Restarted on wake-up. */
+		return;
+	}
+
+	buf = uart_buf_alloc();
+	if (!buf) {
 		LOG_WRN("Not able to allocate UART receive buffer");
-		k_work_reschedule(&uart_work, UART_WAIT_FOR_BUF_DELAY);
+		BRIDGE_STATS_INC(uart_rx_buf_fail);
+		uart_state.rx_err = -ENOMEM;
+		uart_rx_wait_for_buf();
 		return;
 	}
 
-	uart_rx_enable(uart, buf->data, sizeof(buf->data), UART_WAIT_FOR_RX);
+	err = uart_rx_start(buf);
+	event_ring_log(EVENT_UART_RX_RESTART, 0, err);
+	if (err) {
+		uart_buf_free(buf);
+
+		if (err == -EBUSY) {
+			/* Reception was enabled meanwhile. */
+			uart_state.rx_enabled = true;
+			return;
+		}
+
+		LOG_WRN("Cannot enable uart reception (err: %d)", err);
+		k_work_reschedule(&uart_work, UART_WAIT_FOR_BUF_DELAY);
+	}
+}
+
+#if defined(CONFIG_BT_NUS_FAULT_INJECTION)
+static void fault_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(fault_work, fault_work_handler);
+
+static void fault_work_handler(struct k_work *work)
+{
+	/* Fails harmlessly when nothing is being transmitted. */
+	(void)uart_tx_abort(uart);
+
+	k_work_reschedule(&fault_work, K_MSEC(CONFIG_BT_NUS_FAULT_TX_ABORT_INTERVAL));
+}
+#endif /* CONFIG_BT_NUS_FAULT_INJECTION */
+
+#if defined(CONFIG_BT_NUS_HEALTH_MONITOR)
+static bool uart_rx_stalled(void)
+{
+	return !uart_state.rx_enabled && !uart_lp_suspended() &&
+	       ((k_uptime_get() - uart_state.rx_disabled_at) > CONFIG_BT_NUS_HEALTH_RX_TIMEOUT);
+}
+
+static void uart_rx_recover(void)
+{
+	if (uart_state.rx_err == -ENOMEM) {
+		/* Reception is starved of memory, reclaim the data waiting
+		 * to be sent to the UART.
+		 */
+		uart_tx_queue_flush();
+	} else {
+		/* The driver may still consider reception enabled. */
+		uart_rx_disable(uart);
+	}
+
+	k_work_reschedule(&uart_work, K_NO_WAIT);
+}
+
+/* The receiver holds the transmission back through CTS. */
+static bool uart_tx_flow_held(void)
+{
+	uint32_t cts;
+
+	if (!uart_state.flow_ctrl) {
+		return false;
+	}
+
+	/* When CTS cannot be read, the transmission may be held back for
+	 * any time.
+	 */
+	if (uart_line_ctrl_get(uart, UART_LINE_CTRL_CTS, &cts)) {
+		return true;
+	}
+
+	return !cts;
 }
 
+static bool uart_tx_stalled(void)
+{
+	size_t len;
+	int64_t start;
+	uint32_t expected;
+
+	if (!uart_tx_ongoing(&len, &start)) {
+		/* Data was queued while the transmitter went idle. */
+		return uart_tx_busy();
+	}
+
+	if (uart_tx_flow_held()) {
+		return false;
+	}
+
+	/* 10 bits per byte with start and stop bits. */
+	expected = (len * 10 * MSEC_PER_SEC) / uart_state.baudrate +
+		   CONFIG_BT_NUS_HEALTH_TX_MARGIN;
+
+	return (k_uptime_get() - start) > expected;
+}
+
+/* Buffers legitimately held outside of the queues and the driver: one in
+ * ble_write_thread and one in bt_receive_cb.
+ */
+#define UART_BUFS_IN_TRANSIT 2
+/* Consecutive checks with unaccounted buffers before reporting a leak. */
+#define UART_BUF_LEAK_CHECKS 3
+
+static int32_t uart_bufs_leaked(void)
+{
+	int32_t expected = atomic_get(&uart_state.rx_bufs) +
+			   bridge_stats.rx_q_depth + bridge_stats.tx_q_depth +
+			   (uart_tx_ongoing(NULL, NULL) ? 1 : 0) + UART_BUFS_IN_TRANSIT;
+
+	return (int32_t)bridge_stats.buf_in_use - expected;
+}
+
+static bool uart_bufs_stalled(void)
+{
+	static uint8_t suspect;
+
+	suspect = (uart_bufs_leaked() > 0) ? MIN(suspect + 1, UART_BUF_LEAK_CHECKS) : 0;
+
+	return suspect >= UART_BUF_LEAK_CHECKS;
+}
+
+static void uart_bufs_recover(void)
+{
+	int32_t leaked = uart_bufs_leaked();
+
+	BRIDGE_STATS_SET(buf_leaked, MAX(leaked, 0));
+
+	if (leaked >= CONFIG_BT_NUS_HEALTH_LEAK_LIMIT) {
+		health_reboot("buffer leak");
+	}
+}
+
+static struct health_stage uart_rx_stage = {
+	.name = "UART RX",
+	.stalled = uart_rx_stalled,
+	.recover = uart_rx_recover,
+};
+
+static struct health_stage uart_tx_stage = {
+	.name = "UART TX",
+	.stalled = uart_tx_stalled,
+	.recover = uart_tx_drop,
+};
+
+static struct health_stage uart_buf_stage = {
+	.name = "UART buffers",
+	.stalled = uart_bufs_stalled,
+	.recover = uart_bufs_recover,
+};
+#endif /* CONFIG_BT_NUS_HEALTH_MONITOR */
+
 static bool uart_test_async_api(const struct device *dev)
 {
 	const struct uart_driver_api *api =
@@ -237,7 +903,6 @@ static bool uart_test_async_api(const struct device *dev)
 static int uart_init(void)
 {
 	int err;
-	int pos;
 	struct uart_data_t *rx;
 	struct uart_data_t *tx;
 
@@ -253,15 +918,22 @@ static int uart_init(void)
 		}
 	}
 
-	rx = k_malloc(sizeof(*rx));
-	if (rx) {
-		rx->len = 0;
-	} else {
+	rx = uart_buf_alloc();
+	if (!rx) {
 		return -ENOMEM;
 	}
 
 	k_work_init_delayable(&uart_work, uart_work_handler);
+	uart_tx_init(uart);
 
+#if defined(CONFIG_BT_NUS_UART_LP)
+	err = uart_lp_init();
+	if (err) {
+		uart_buf_free(rx);
+		LOG_ERR("Cannot initialize the UART wake-up line (err: %d)", err);
+		return err;
+	}
+#endif
 
 	if (IS_ENABLED(CONFIG_UART_ASYNC_ADAPTER) && !uart_test_async_api(uart)) {
 		/* Implement API adapter */
@@ -269,9 +941,9 @@ static int uart_init(void)
 		uart = async_adapter;
 	}
 
-	err = uart_callback_set(uart, uart_cb, NULL);
+	err = uart_callback_set(uart, UART_CB, NULL);
 	if (err) {
-		k_free(rx);
+		uart_buf_free(rx);
 		LOG_ERR("Cannot initialize UART callback");
 		return err;
 	}
@@ -299,46 +971,94 @@ static int uart_init(void)
 		}
 	}
 
-	tx = k_malloc(sizeof(*tx));
+	tx = uart_buf_alloc();
 
 	if (tx) {
-		pos = snprintf(tx->data, sizeof(tx->data),
-			       "Starting Nordic UART service sample\r\n");
-
-		if ((pos < 0) || (pos >= sizeof(tx->data))) {
-			k_free(rx);
-			k_free(tx);
-			LOG_ERR("snprintf returned %d", pos);
-			return -ENOMEM;
-		}
-
-		tx->len = pos;
+		/* Copied rather than formatted, keeping snprintf() out of
+		 * the image.
+		 */
+		memcpy(tx->data, UART_WELCOME, sizeof(UART_WELCOME) - 1);
+		tx->len = sizeof(UART_WELCOME) - 1;
 	} else {
-		k_free(rx);
+		uart_buf_free(rx);
 		return -ENOMEM;
 	}
 
-	err = uart_tx(uart, tx->data, tx->len, SYS_FOREVER_MS);
+	if (IS_ENABLED(CONFIG_BT_NUS_HEALTH_MONITOR)) {
+		struct uart_config cfg;
+
+		if (uart_config_get(uart, &cfg)) {
+			uart_state.baudrate = 115200;
+		} else {
+			uart_state.baudrate = cfg.baudrate;
+			uart_state.flow_ctrl = (cfg.flow_ctrl == UART_CFG_FLOW_CTRL_RTS_CTS);
+		}
+	}
+
+	err = uart_tx_start(tx, 0);
 	if (err) {
-		k_free(rx);
-		k_free(tx);
+		uart_buf_free(rx);
+		uart_buf_free(tx);
 		LOG_ERR("Cannot display welcome message (err: %d)", err);
 		return err;
 	}
 
-	err = uart_rx_enable(uart, rx->data, sizeof(rx->data), UART_WAIT_FOR_RX);
+	err = uart_rx_start(rx);
 	if (err) {
 		LOG_ERR("Cannot enable uart reception (err: %d)", err);
 		/* Free the rx buffer only because the tx buffer will be handled in the callback */
-		k_free(rx);
+		uart_buf_free(rx);
 	}
 
+#if defined(CONFIG_BT_NUS_FAULT_INJECTION)
+	LOG_WRN("Fault injection enabled");
+	k_work_reschedule(&fault_work, K_MSEC(CONFIG_BT_NUS_FAULT_TX_ABORT_INTERVAL));
+#endif
+
+#if defined(CONFIG_BT_NUS_HEALTH_MONITOR)
+	health_stage_register(&uart_rx_stage);
+	health_stage_register(&uart_tx_stage);
+	health_stage_register(&uart_buf_stage);
+#endif
+
 	return err;
 }
 
+#if defined(CONFIG_BT_NUS_LONG_RANGE)
+static int adv_long_range_start(void)
+{
+	int err;
+
+	if (!adv_set) {
+		err = bt_le_ext_adv_create(BT_LE_ADV_PARAM(BT_LE_ADV_OPT_CONN |
+							   BT_LE_ADV_OPT_EXT_ADV |
+							   BT_LE_ADV_OPT_CODED,
+							   BT_GAP_ADV_FAST_INT_MIN_2,
+							   BT_GAP_ADV_FAST_INT_MAX_2, NULL),
+					   NULL, &adv_set);
+		if (err) {
+			return err;
+		}
+
+		err = bt_le_ext_adv_set_data(adv_set, ad_ext, ARRAY_SIZE(ad_ext), NULL, 0);
+		if (err) {
+			bt_le_ext_adv_delete(adv_set);
+			adv_set = NULL;
+			return err;
+		}
+	}
+
+	return bt_le_ext_adv_start(adv_set, BT_LE_EXT_ADV_START_DEFAULT);
+}
+#endif /* CONFIG_BT_NUS_LONG_RANGE */
+
 static void adv_work_handler(struct k_work *work)
 {
+#if defined(CONFIG_BT_NUS_LONG_RANGE)
+	int err = adv_long_range_start();
+#else
 	int err = bt_le_adv_start(BT_LE_ADV_CONN_FAST_2, ad, ARRAY_SIZE(ad), sd, ARRAY_SIZE(sd));
+#endif
 
 	if (err) {
 		LOG_ERR("Advertising failed to start (err %d)", err);
@@ -353,10 +1073,69 @@ static void advertising_start(void)
 	k_work_submit(&adv_work);
 }
 
+/* Central links of the gateway are handled by nus_central. */
+static bool conn_is_peripheral(struct bt_conn *conn)
+{
+	struct bt_conn_info info;
+
+	if (!IS_ENABLED(CONFIG_BT_CENTRAL)) {
+		return true;
+	}
+
+	return !bt_conn_get_info(conn, &info) && (info.role == BT_CONN_ROLE_PERIPHERAL);
+}
+
+enum first_data {
+	FIRST_DATA_RX,
+	FIRST_DATA_TX,
+};
+
+#if defined(CONFIG_BT_NUS_STATS)
+/* Time from the connection to the first data exchanged over NUS, which
+ * includes the GATT discovery of the central.
+ */
+static atomic_t first_data_pending;
+static int64_t first_data_conn_at;
+
+static void first_data_start(void)
+{
+	first_data_conn_at = k_uptime_get();
+	atomic_set(&first_data_pending, BIT(FIRST_DATA_RX) | BIT(FIRST_DATA_TX));
+}
+
+static void first_data_account(enum first_data dir)
+{
+	uint32_t ms;
+
+	if (!atomic_test_and_clear_bit(&first_data_pending, dir)) {
+		return;
+	}
+
+	ms = k_uptime_get() - first_data_conn_at;
+
+	if (dir == FIRST_DATA_RX) {
+		BRIDGE_STATS_SET(conn_first_rx_ms, ms);
+	} else {
+		BRIDGE_STATS_SET(conn_first_tx_ms, ms);
+	}
+
+	LOG_INF("First %s %u ms after connection", (dir == FIRST_DATA_RX) ? "write" :
+		"notification", ms);
+}
+#else
+static void first_data_start(void) {}
+
+static void first_data_account(enum first_data dir) {}
+#endif /* CONFIG_BT_NUS_STATS */
+
 static void connected(struct bt_conn *conn, uint8_t err)
 {
 	char addr[BT_ADDR_LE_STR_LEN];
 
+	if (!conn_is_peripheral(conn)) {
+		return;
+	}
+
 	if (err) {
 		LOG_ERR("Connection failed, err 0x%02x %s", err, bt_hci_err_to_str(err));
 		return;
@@ -366,14 +1145,35 @@ static void connected(struct bt_conn *conn, uint8_t err)
 	LOG_INF("Connected %s", addr);
 
 	current_conn = bt_conn_ref(conn);
+	first_data_start();
 
 	dk_set_led_on(CON_STATUS_LED);
+
+#if defined(CONFIG_BT_NUS_LONG_RANGE)
+	struct bt_conn_info info;
+
+	if (!bt_conn_get_info(conn, &info)) {
+		conn_coded = (info.le.phy->tx_phy == BT_GAP_LE_PHY_CODED);
+		LOG_INF("Connected on the %s PHY", conn_coded ? "Coded" : "1M");
+	}
+
+	/* Fewer, fuller PDUs make the best of the long-range link. */
+	int ret = bt_conn_le_data_len_update(conn, BT_LE_DATA_LEN_PARAM_MAX);
+
+	if (ret) {
+		LOG_WRN("Data length update failed (err %d)", ret);
+	}
+#endif
 }
 
 static void disconnected(struct bt_conn *conn, uint8_t reason)
 {
 	char addr[BT_ADDR_LE_STR_LEN];
 
+	if (!conn_is_peripheral(conn)) {
+		return;
+	}
+
 	bt_addr_le_to_str(bt_conn_get_dst(conn), addr, sizeof(addr));
 
 	LOG_INF("Disconnected: %s, reason 0x%02x %s", addr, reason, bt_hci_err_to_str(reason));
@@ -386,14 +1186,28 @@ static void disconnected(struct bt_conn *conn, uint8_t reason)
 	if (current_conn) {
 		bt_conn_unref(current_conn);
 		current_conn = NULL;
+		conn_coded = false;
 		dk_set_led_off(CON_STATUS_LED);
 	}
 }
 
+#if defined(CONFIG_BT_NUS_LONG_RANGE)
+static void le_phy_updated(struct bt_conn *conn, struct bt_conn_le_phy_info *param)
+{
+	if (conn == current_conn) {
+		conn_coded = (param->tx_phy == BT_GAP_LE_PHY_CODED);
+	}
+}
+#endif
+
 static void recycled_cb(void)
 {
 	LOG_INF("Connection object available from previous conn. Disconnect is complete!");
-	advertising_start();
+
+	/* Central links are recycled while the peripheral one is up. */
+	if (!current_conn) {
+		advertising_start();
+	}
 }
 
 #ifdef CONFIG_BT_NUS_SECURITY_ENABLED
@@ -420,6 +1234,9 @@ BT_CONN_CB_DEFINE(conn_callbacks) = {
 #ifdef CONFIG_BT_NUS_SECURITY_ENABLED
 	.security_changed = security_changed,
 #endif
+#if defined(CONFIG_BT_NUS_LONG_RANGE)
+	.le_phy_updated   = le_phy_updated,
+#endif
 };
 
 #if defined(CONFIG_BT_NUS_SECURITY_ENABLED)
@@ -495,24 +1312,22 @@ static struct bt_conn_auth_cb conn_auth_callbacks;
 static struct bt_conn_auth_info_cb conn_auth_info_callbacks;
 #endif
 
-static void bt_receive_cb(struct bt_conn *conn, const uint8_t *const data,
-			  uint16_t len)
+static HOT_PATH void uart_write(const uint8_t *data, uint16_t len, bool add_lf)
 {
-	int err;
-	char addr[BT_ADDR_LE_STR_LEN] = {0};
-
-	bt_addr_le_to_str(bt_conn_get_dst(conn), addr, ARRAY_SIZE(addr));
-
-	LOG_INF("Received data from: %s", addr);
+	uart_lp_wake();
+	uart_lp_activity();
 
 	for (uint16_t pos = 0; pos != len;) {
-		struct uart_data_t *tx = k_malloc(sizeof(*tx));
+		struct uart_data_t *tx = uart_buf_alloc();
 
 		if (!tx) {
 			LOG_WRN("Not able to allocate UART send data buffer");
+			BRIDGE_STATS_INCN(ble_rx_drop, len - pos);
 			return;
 		}
 
+		UART_BUF_OWNER(tx, BUF_OWNER_BLE_RX);
+
 		/* Keep the last byte of TX buffer for potential LF char. */
 		size_t tx_data_size = sizeof(tx->data) - 1;
 
@@ -529,26 +1344,119 @@ static void bt_receive_cb(struct bt_conn *conn, const uint8_t *const data,
 		/* Append the LF character when the CR character triggered
 		 * transmission from the peer.
 		 */
-		if ((pos == len) && (data[len - 1] == '\r')) {
+		if (add_lf && (pos == len) && (data[len - 1] == '\r')) {
 			tx->data[tx->len] = '\n';
 			tx->len++;
 		}
 
-		err = uart_tx(uart, tx->data, tx->len, SYS_FOREVER_MS);
-		if (err) {
-			k_fifo_put(&fifo_uart_tx_data, tx);
+		uart_tx_send(tx);
+	}
+}
+
+void bridge_uart_write(const uint8_t *data, uint16_t len)
+{
+	uart_write(data, len, true);
+}
+
+void bridge_uart_write_raw(const uint8_t *data, uint16_t len)
+{
+	uart_write(data, len, false);
+}
+
+static HOT_PATH void bt_receive_cb(struct bt_conn *conn, const uint8_t *data,
+				   uint16_t len)
+{
+	char addr[BT_ADDR_LE_STR_LEN] = {0};
+
+	bt_addr_le_to_str(bt_conn_get_dst(conn), addr, ARRAY_SIZE(addr));
+
+	LOG_INF("Received data from: %s", addr);
+
+	BRIDGE_STATS_INCN(ble_rx_bytes, len);
+	link_pm_activity();
+	settings_sched_activity();
+	first_data_account(FIRST_DATA_RX);
+
+	if (IS_ENABLED(CONFIG_BT_NUS_GATEWAY)) {
+		gateway_local_received(data, len);
+		return;
+	}
+
+	if (IS_ENABLED(CONFIG_BT_NUS_UART_CHANNELS)) {
+		const struct uart_chan_hdr *hdr = (const void *)data;
+
+		if (len < sizeof(*hdr)) {
+			return;
+		}
+
+		data += sizeof(*hdr);
+		len -= sizeof(*hdr);
+
+		if (hdr->chan != UART_CHAN_PRIMARY) {
+			if (uart_chan_write(hdr->chan, data, len) == -EINVAL) {
+				LOG_WRN("Data for unknown channel %u", hdr->chan);
+			}
+			return;
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_BT_NUS_RELAY)) {
+		relay_downstream_received(data, len);
+		return;
+	}
+
+	if (IS_ENABLED(CONFIG_BT_NUS_RELAY_TRACE)) {
+		if (len < sizeof(struct relay_trace_hdr)) {
+			return;
 		}
+
+		relay_trace_account((const void *)data, len - sizeof(struct relay_trace_hdr));
+		data += sizeof(struct relay_trace_hdr);
+		len -= sizeof(struct relay_trace_hdr);
+	}
+
+	if (IS_ENABLED(CONFIG_BT_NUS_RELIABLE)) {
+		reliable_received(data, len);
+		return;
 	}
+
+	bridge_uart_write(data, len);
+}
+
+#if defined(CONFIG_BT_NUS_HOT_PATH_CYCLES)
+static void bt_receive_cb_timed(struct bt_conn *conn, const uint8_t *data, uint16_t len)
+{
+	timing_t start = timing_counter_get();
+
+	bt_receive_cb(conn, data, len);
+
+	BRIDGE_STATS_SET(hp_ble_rx_ns, hot_path_ns(start, bridge_stats.hp_ble_rx_ns));
+}
+#define BT_RECEIVE_CB bt_receive_cb_timed
+#else
+#define BT_RECEIVE_CB bt_receive_cb
+#endif /* CONFIG_BT_NUS_HOT_PATH_CYCLES */
+
+static void bt_sent_cb(struct bt_conn *conn)
+{
+	batch_ctrl_tx_done(conn);
+	settings_sched_sent();
+	first_data_account(FIRST_DATA_TX);
 }
 
 static struct bt_nus_cb nus_cb = {
-	.received = bt_receive_cb,
+	.received = BT_RECEIVE_CB,
+	.sent = bt_sent_cb,
 };
 
 void error(void)
 {
 	dk_set_leds_state(DK_ALL_LEDS_MSK, DK_NO_LEDS_MSK);
 
+	if (IS_ENABLED(CONFIG_BT_NUS_HEALTH_MONITOR)) {
+		health_reboot("initialization failed");
+	}
+
 	while (true) {
 		/* Spin for ever */
 		k_sleep(K_MSEC(1000));
@@ -603,6 +1511,23 @@ static void configure_gpio(void)
 	}
 }
 
+/* Show that the bridge runs without waking the CPU up. */
+static void run_led_start(void)
+{
+#if DT_HAS_ALIAS(pwm_led0) && defined(CONFIG_PWM)
+	static const struct pwm_dt_spec run_led = PWM_DT_SPEC_GET(DT_ALIAS(pwm_led0));
+
+	if (pwm_is_ready_dt(&run_led) &&
+	    !pwm_set_pulse_dt(&run_led, run_led.period / RUN_LED_PWM_DIM)) {
+		return;
+	}
+
+	LOG_WRN("Cannot drive the run status LED with PWM");
+#endif
+
+	dk_set_led_on(RUN_STATUS_LED);
+}
+
 int main(void)
 {
 	int blink_status = 0;
@@ -610,11 +1535,49 @@ int main(void)
 
 	configure_gpio();
 
+	if (IS_ENABLED(CONFIG_BT_NUS_EVENT_RING)) {
+		event_ring_init();
+	}
+
+	if (IS_ENABLED(CONFIG_BT_NUS_STATS)) {
+		err = bridge_stats_init();
+		if (err) {
+			LOG_WRN("Bridge statistics are not available");
+		}
+	}
+
+#if defined(CONFIG_BT_NUS_HOT_PATH_CYCLES)
+	timing_init();
+	timing_start();
+#endif
+
+#if defined(CONFIG_BT_NUS_HOT_PATH_RAM)
+	LOG_INF("Code in RAM: %u bytes", (uint32_t)(uintptr_t)__ramfunc_size);
+#endif
+
 	err = uart_init();
 	if (err) {
 		error();
 	}
 
+	if (IS_ENABLED(CONFIG_BT_NUS_UART_CHANNELS)) {
+		err = uart_chan_init();
+		if (err) {
+			error();
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_BT_NUS_HEALTH_MONITOR)) {
+		health_init();
+	}
+
+	if (IS_ENABLED(CONFIG_BT_NUS_RELIABLE)) {
+		err = reliable_init();
+		if (err) {
+			error();
+		}
+	}
+
 	if (IS_ENABLED(CONFIG_BT_NUS_SECURITY_ENABLED)) {
 		err = bt_conn_auth_cb_register(&conn_auth_callbacks);
 		if (err) {
@@ -642,55 +1605,382 @@ int main(void)
 		settings_load();
 	}
 
+	if (IS_ENABLED(CONFIG_BT_NUS_SETTINGS_SCHED)) {
+		err = settings_sched_init();
+		if (err) {
+			LOG_WRN("Settings writes are not scheduled (err: %d)", err);
+		}
+	}
+
 	err = bt_nus_init(&nus_cb);
 	if (err) {
 		LOG_ERR("Failed to initialize UART service (err: %d)", err);
 		return 0;
 	}
 
+	if (IS_ENABLED(CONFIG_BT_NUS_QOS)) {
+		err = qos_init();
+		if (err) {
+			LOG_ERR("Failed to initialize QoS arbitration (err: %d)", err);
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_BT_NUS_CONN_EVT_STATS)) {
+		err = conn_evt_init();
+		if (err) {
+			LOG_WRN("Connection event metrics are not available");
+		}
+	}
+
 	k_work_init(&adv_work, adv_work_handler);
 	advertising_start();
 
+	if (IS_ENABLED(CONFIG_BT_NUS_BROADCAST)) {
+		err = broadcast_init();
+		if (err) {
+			error();
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_BT_NUS_ISO)) {
+		err = iso_init();
+		if (err) {
+			error();
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_BT_NUS_GATEWAY)) {
+		err = gateway_init();
+		if (err) {
+			error();
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_BT_NUS_RELAY)) {
+		err = relay_init();
+		if (err) {
+			error();
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_BT_NUS_LOW_WAKE)) {
+		run_led_start();
+		return 0;
+	}
+
 	for (;;) {
 		dk_set_led(RUN_STATUS_LED, (++blink_status) % 2);
 		k_sleep(K_MSEC(RUN_LED_BLINK_INTERVAL));
 	}
 }
 
+static size_t nus_max_payload(void)
+{
+	size_t max_payload = NUS_BATCH_SIZE;
+
+	if (IS_ENABLED(CONFIG_BT_NUS_BATCH_ADAPTIVE) && current_conn) {
+		max_payload = MIN(max_payload, bt_nus_get_mtu(current_conn) - NUS_HDR_SIZE);
+	}
+
+	if (IS_ENABLED(CONFIG_BT_NUS_PHY_ADAPTIVE)) {
+		max_payload = MIN(max_payload, phy_mgr_max_payload() - NUS_HDR_SIZE);
+	}
+
+	return max_payload;
+}
+
+static k_timeout_t nus_batch_timeout(const struct nus_batch *batch,
+				     const struct batch_ctrl_params *params)
+{
+	uint32_t age;
+
+	if ((batch->len == 0) || (params->hold_ms == SYS_FOREVER_MS)) {
+		return K_FOREVER;
+	}
+
+	age = k_cyc_to_ms_floor32(k_cycle_get_32() - batch->timestamp);
+
+	return (age < params->hold_ms) ? K_MSEC(params->hold_ms - age) : K_NO_WAIT;
+}
+
+#if defined(CONFIG_BT_NUS_DEADLINE)
+static void deadline_account(const struct nus_batch *batch)
+{
+	uint32_t wait_us = k_cyc_to_us_floor32(k_cycle_get_32() - batch->timestamp);
+	uint32_t fill_pct = batch->len * 100 / nus_max_payload();
+
+	if (wait_us > (CONFIG_BT_NUS_DEADLINE_MS * USEC_PER_MSEC)) {
+		LOG_DBG("Deadline missed by %u us",
+			wait_us - CONFIG_BT_NUS_DEADLINE_MS * USEC_PER_MSEC);
+		BRIDGE_STATS_INC(dl_misses);
+	}
+
+	BRIDGE_STATS_SET(dl_max_wait_us, MAX(bridge_stats.dl_max_wait_us, wait_us));
+	BRIDGE_STATS_SET(dl_fill_pct, (3 * bridge_stats.dl_fill_pct + MIN(fill_pct, 100)) / 4);
+}
+#endif /* CONFIG_BT_NUS_DEADLINE */
+
+static void nus_batch_flush(struct nus_batch *batch)
+{
+	int err;
+
+	if (batch->len == 0) {
+		return;
+	}
+
+#if defined(CONFIG_BT_NUS_DEADLINE)
+	deadline_account(batch);
+#endif
+
+	if (IS_ENABLED(CONFIG_BT_NUS_ISO)) {
+		err = iso_send(batch->data, batch->len, batch->timestamp);
+		if (err != -ENOTCONN) {
+			bridge_stats_latency(batch->timestamp);
+			batch->len = 0;
+			return;
+		}
+
+		/* Fall back to notifications until the stream is set up. */
+	}
+
+	if (IS_ENABLED(CONFIG_BT_NUS_BROADCAST)) {
+		err = broadcast_send(batch->data, batch->len);
+		if (!err) {
+			BRIDGE_STATS_INCN(ble_tx_bytes, batch->len);
+			bridge_stats_latency(batch->timestamp);
+		}
+
+		batch->len = 0;
+		return;
+	}
+
+	qos_nus_acquire(batch->len);
+
+	if (IS_ENABLED(CONFIG_BT_NUS_RELIABLE)) {
+		/* Waits for room in the backlog while connected, segments
+		 * that cannot be sent now are retransmitted.
+		 */
+		reliable_send(batch->data, batch->len);
+		BRIDGE_STATS_INCN(ble_tx_bytes, batch->len);
+		bridge_stats_latency(batch->timestamp);
+		batch->len = 0;
+		return;
+	}
+
+#if defined(CONFIG_BT_NUS_UART_CHANNELS)
+	batch->hdr.chan = UART_CHAN_PRIMARY;
+	err = bt_nus_send(NULL, (const uint8_t *)&batch->hdr, sizeof(batch->hdr) + batch->len);
+#elif defined(CONFIG_BT_NUS_RELAY_TRACE)
+	relay_trace_stamp(&batch->trace);
+	err = bt_nus_send(NULL, (const uint8_t *)&batch->trace,
+			  sizeof(batch->trace) + batch->len);
+#else
+	err = bt_nus_send(NULL, batch->data, batch->len);
+#endif
+	if (err) {
+		LOG_WRN("Failed to send data over BLE connection");
+		BRIDGE_STATS_INC(ble_tx_fail);
+		event_ring_log(EVENT_BLE_SEND_FAIL, batch->len, err);
+	} else {
+		BRIDGE_STATS_INC(ble_tx_pkts);
+		BRIDGE_STATS_INCN(ble_tx_bytes, batch->len);
+		bridge_stats_latency(batch->timestamp);
+		batch_ctrl_sent();
+		conn_evt_notify_submitted(batch->len);
+	}
+
+	batch->len = 0;
+}
+
+static struct uart_data_t *uart_rx_get(k_timeout_t timeout)
+{
+#if defined(CONFIG_BT_NUS_LANES)
+	struct k_poll_event events[] = {
+		K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+					 K_POLL_MODE_NOTIFY_ONLY, &fifo_uart_rx_prio),
+		K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+					 K_POLL_MODE_NOTIFY_ONLY, &fifo_uart_rx_data),
+	};
+	struct uart_data_t *buf;
+
+	buf = k_fifo_get(&fifo_uart_rx_prio, K_NO_WAIT);
+	if (!buf) {
+		buf = k_fifo_get(&fifo_uart_rx_data, K_NO_WAIT);
+	}
+
+	if (buf || k_poll(events, ARRAY_SIZE(events), timeout)) {
+		return buf;
+	}
+
+	buf = k_fifo_get(&fifo_uart_rx_prio, K_NO_WAIT);
+
+	return buf ? buf : k_fifo_get(&fifo_uart_rx_data, K_NO_WAIT);
+#else
+	return k_fifo_get(&fifo_uart_rx_data, timeout);
+#endif
+}
+
+static void lane_delay(const struct uart_data_t *buf, bool prio)
+{
+	uint32_t delay_us = k_cyc_to_us_floor32(k_cycle_get_32() - buf->timestamp);
+
+	if (prio) {
+		BRIDGE_STATS_INC(lane_hi_bufs);
+		BRIDGE_STATS_SET(lane_hi_delay_us, delay_us);
+		BRIDGE_STATS_SET(lane_hi_max_us, MAX(bridge_stats.lane_hi_max_us, delay_us));
+	} else {
+		BRIDGE_STATS_SET(lane_lo_delay_us, delay_us);
+		BRIDGE_STATS_SET(lane_lo_max_us, MAX(bridge_stats.lane_lo_max_us, delay_us));
+	}
+}
+
+/* Send high priority data right away, in notifications of its own, ahead of
+ * the bulk data being batched.
+ */
+static void lane_prio_send(struct uart_data_t *buf)
+{
+	static struct nus_batch prio_data;
+	size_t max_payload = nus_max_payload();
+
+	lane_delay(buf, true);
+
+	for (uint16_t loc = 0, len; loc < buf->len; loc += len) {
+		/* Saved, since the flush empties the batch. */
+		len = MIN(max_payload, buf->len - loc);
+		prio_data.len = len;
+		prio_data.timestamp = buf->timestamp;
+		memcpy(prio_data.data, &buf->data[loc], len);
+		nus_batch_flush(&prio_data);
+	}
+
+	uart_buf_free(buf);
+}
+
+static void lane_prio_drain(void)
+{
+#if defined(CONFIG_BT_NUS_LANES)
+	struct uart_data_t *buf;
+
+	while ((buf = k_fifo_get(&fifo_uart_rx_prio, K_NO_WAIT)) != NULL) {
+		bridge_stats_queue_get(BRIDGE_QUEUE_UART_RX);
+		UART_BUF_OWNER(buf, BUF_OWNER_BLE_WRITE);
+		lane_prio_send(buf);
+	}
+#endif
+}
+
+/* Copy data from the UART buffer into the batch up to a full batch, return
+ * true if the batch must be sent.
+ */
+static HOT_PATH bool nus_batch_fill(struct nus_batch *batch, const struct uart_data_t *buf,
+				    uint16_t *loc, size_t max_payload,
+				    const struct batch_ctrl_params *params)
+{
+	size_t plen = MIN(max_payload - batch->len, buf->len - *loc);
+
+	if (batch->len == 0) {
+		batch->timestamp = buf->timestamp;
+	}
+
+	memcpy(&batch->data[batch->len], &buf->data[*loc], plen);
+	batch->len += plen;
+	*loc += plen;
+
+	return (batch->len >= params->threshold) ||
+	       (batch->len >= max_payload) ||
+	       (params->flush_on_eol &&
+		((batch->data[batch->len - 1] == '\n') ||
+		 (batch->data[batch->len - 1] == '\r')));
+}
+
 void ble_write_thread(void)
 {
 	/* Don't go any further until BLE is initialized */
 	k_sem_take(&ble_init_ok, K_FOREVER);
-	struct uart_data_t nus_data = {
-		.len = 0,
+	static struct nus_batch nus_data;
+	struct batch_ctrl_params params = {
+		.hold_ms = SYS_FOREVER_MS,
 	};
 
 	for (;;) {
-		/* Wait indefinitely for data to be sent over bluetooth */
-		struct uart_data_t *buf = k_fifo_get(&fifo_uart_rx_data,
-						     K_FOREVER);
-
-		int plen = MIN(sizeof(nus_data.data) - nus_data.len, buf->len);
-		int loc = 0;
-
-		while (plen > 0) {
-			memcpy(&nus_data.data[nus_data.len], &buf->data[loc], plen);
-			nus_data.len += plen;
-			loc += plen;
-
-			if (nus_data.len >= sizeof(nus_data.data) ||
-			   (nus_data.data[nus_data.len - 1] == '\n') ||
-			   (nus_data.data[nus_data.len - 1] == '\r')) {
-				if (bt_nus_send(NULL, nus_data.data, nus_data.len)) {
-					LOG_WRN("Failed to send data over BLE connection");
-				}
-				nus_data.len = 0;
+		/* Wait for data to be sent over bluetooth, or until the
+		 * pending data has been held for long enough.
+		 */
+		struct uart_data_t *buf = uart_rx_get(nus_batch_timeout(&nus_data, &params));
+
+		if (!buf) {
+			if (IS_ENABLED(CONFIG_BT_NUS_DEADLINE) && (nus_data.len > 0)) {
+				BRIDGE_STATS_INC(dl_forced);
 			}
 
-			plen = MIN(sizeof(nus_data.data), buf->len - loc);
+			nus_batch_flush(&nus_data);
+			continue;
+		}
+
+		bridge_stats_queue_get(BRIDGE_QUEUE_UART_RX);
+		UART_BUF_OWNER(buf, BUF_OWNER_BLE_WRITE);
+
+		if (IS_ENABLED(CONFIG_BT_NUS_GATEWAY)) {
+			gateway_uart_rx(buf->data, buf->len);
+			uart_buf_free(buf);
+			continue;
+		}
+
+#if defined(CONFIG_BT_NUS_LANES)
+		if (buf->prio) {
+			lane_prio_send(buf);
+			continue;
+		}
+
+		lane_delay(buf, false);
+#endif
+
+		size_t max_payload = nus_max_payload();
+
+		batch_ctrl_update(buf->len, max_payload, &params);
+
+		if (IS_ENABLED(CONFIG_BT_NUS_LONG_RANGE) && conn_coded) {
+			/* Each PDU costs around 8 times more air time on the
+			 * Coded PHY, aggregate into full notifications.
+			 */
+			params.threshold = max_payload;
+			params.hold_ms = CONFIG_BT_NUS_LONG_RANGE_HOLD;
+			params.flush_on_eol = false;
+		}
+
+		if (IS_ENABLED(CONFIG_BT_NUS_DEADLINE)) {
+			/* Let the batch grow up to a full notification, the
+			 * deadline of its oldest byte bounds the wait.
+			 */
+			params.threshold = max_payload;
+			params.hold_ms = DEADLINE_HOLD_MS;
+			params.flush_on_eol = false;
+		}
+
+		/* The payload limit shrinks if the MTU changed meanwhile. */
+		if (nus_data.len >= max_payload) {
+			nus_batch_flush(&nus_data);
+		}
+
+		for (uint16_t loc = 0; loc < buf->len;) {
+#if defined(CONFIG_BT_NUS_HOT_PATH_CYCLES)
+			timing_t start = timing_counter_get();
+			bool flush = nus_batch_fill(&nus_data, buf, &loc, max_payload, &params);
+
+			BRIDGE_STATS_SET(hp_fill_ns, hot_path_ns(start, bridge_stats.hp_fill_ns));
+#else
+			bool flush = nus_batch_fill(&nus_data, buf, &loc, max_payload, &params);
+#endif
+
+			if (flush) {
+				nus_batch_flush(&nus_data);
+
+				/* Preempt the bulk data between notifications. */
+				lane_prio_drain();
+			}
 		}
 
-		k_free(buf);
+		uart_buf_free(buf);
 	}
 }
 
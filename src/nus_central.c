@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/ring_buffer.h>
+
+#include <bluetooth/gatt_dm.h>
+#include <bluetooth/scan.h>
+#include <bluetooth/services/nus.h>
+#include <bluetooth/services/nus_client.h>
+
+#include <zephyr/logging/log.h>
+
+#include "nus_central.h"
+
+LOG_MODULE_DECLARE(peripheral_uart);
+
+/* ATT write command header. */
+#define ATT_WRITE_OVERHEAD 3
+/* Largest write to a peer. */
+#define WRITE_MAX_LEN (CONFIG_BT_L2CAP_TX_MTU - ATT_WRITE_OVERHEAD)
+
+struct nus_link {
+	struct bt_conn *conn;
+	struct bt_nus_client client;
+	struct bt_gatt_exchange_params mtu_params;
+	/* Writes queued for the peer, each prefixed with its length. */
+	struct ring_buf tx_ring;
+	uint8_t tx_ring_data[CONFIG_BT_NUS_CENTRAL_TX_BUF_SIZE];
+	struct k_work tx_work;
+	/* The NUS client supports one write at a time. */
+	atomic_t writing;
+	uint8_t write_data[WRITE_MAX_LEN];
+	bool ready;
+};
+
+static struct k_spinlock lock;
+
+static struct nus_link links[CONFIG_BT_NUS_CENTRAL_MAX_LINKS];
+static const struct nus_central_cb *central_cb;
+static atomic_t ready_count;
+
+static struct nus_link *link_get(struct bt_conn *conn)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(links); i++) {
+		if (links[i].conn == conn) {
+			return &links[i];
+		}
+	}
+
+	return NULL;
+}
+
+static uint8_t link_id(const struct nus_link *link)
+{
+	return link - links;
+}
+
+static void scan_resume(void)
+{
+	int err;
+
+	if (!link_get(NULL)) {
+		/* All slots in use. */
+		return;
+	}
+
+	err = bt_scan_start(BT_SCAN_TYPE_SCAN_ACTIVE);
+	if (err && (err != -EALREADY)) {
+		LOG_ERR("Scanning failed to start (err %d)", err);
+	}
+}
+
+static uint8_t client_received(struct bt_nus_client *nus, const uint8_t *data, uint16_t len)
+{
+	struct nus_link *link = CONTAINER_OF(nus, struct nus_link, client);
+
+	if (central_cb->received) {
+		central_cb->received(link_id(link), data, len);
+	}
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static void tx_work_handler(struct k_work *work)
+{
+	struct nus_link *link = CONTAINER_OF(work, struct nus_link, tx_work);
+	k_spinlock_key_t key;
+	uint16_t len;
+	int err;
+
+	while (link->ready && atomic_cas(&link->writing, 0, 1)) {
+		key = k_spin_lock(&lock);
+
+		if (ring_buf_get(&link->tx_ring, (uint8_t *)&len, sizeof(len)) == 0) {
+			k_spin_unlock(&lock, key);
+			atomic_clear(&link->writing);
+			return;
+		}
+
+		ring_buf_get(&link->tx_ring, link->write_data, len);
+		k_spin_unlock(&lock, key);
+
+		err = bt_nus_client_send(&link->client, link->write_data, len);
+		if (!err) {
+			/* client_sent() resubmits the work. */
+			return;
+		}
+
+		LOG_WRN("Cannot write to NUS peer %u (err %d)", link_id(link), err);
+		atomic_clear(&link->writing);
+	}
+}
+
+static void tx_flush(struct nus_link *link)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	ring_buf_reset(&link->tx_ring);
+	k_spin_unlock(&lock, key);
+
+	atomic_clear(&link->writing);
+}
+
+static void client_sent(struct bt_nus_client *nus, uint8_t err, const uint8_t *const data,
+			uint16_t len)
+{
+	struct nus_link *link = CONTAINER_OF(nus, struct nus_link, client);
+
+	if (err) {
+		LOG_WRN("Write to NUS peer failed (err %d)", err);
+	}
+
+	atomic_clear(&link->writing);
+	k_work_submit(&link->tx_work);
+}
+
+static void discovery_complete(struct bt_gatt_dm *dm, void *context)
+{
+	struct nus_link *link = context;
+	int err;
+
+	bt_nus_handles_assign(dm, &link->client);
+	err = bt_nus_subscribe_receive(&link->client);
+	bt_gatt_dm_data_release(dm);
+
+	if (err) {
+		LOG_ERR("Cannot subscribe to NUS peer %u (err %d)", link_id(link), err);
+		bt_conn_disconnect(link->conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+		return;
+	}
+
+	link->ready = true;
+	atomic_inc(&ready_count);
+
+	LOG_INF("NUS peer %u ready", link_id(link));
+
+	if (central_cb->ready) {
+		central_cb->ready(link_id(link));
+	}
+}
+
+static void discovery_service_not_found(struct bt_conn *conn, void *context)
+{
+	LOG_WRN("NUS service not found");
+	bt_conn_disconnect(conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+}
+
+static void discovery_error(struct bt_conn *conn, int err, void *context)
+{
+	LOG_WRN("NUS discovery failed (err %d)", err);
+	bt_conn_disconnect(conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+}
+
+static const struct bt_gatt_dm_cb discovery_cb = {
+	.completed = discovery_complete,
+	.service_not_found = discovery_service_not_found,
+	.error_found = discovery_error,
+};
+
+static void mtu_exchanged(struct bt_conn *conn, uint8_t err,
+			  struct bt_gatt_exchange_params *params)
+{
+	struct nus_link *link = link_get(conn);
+	int ret;
+
+	if (!link) {
+		return;
+	}
+
+	ret = bt_gatt_dm_start(conn, BT_UUID_NUS_SERVICE, &discovery_cb, link);
+	if (ret) {
+		LOG_ERR("Cannot start NUS discovery (err %d)", ret);
+		bt_conn_disconnect(conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+	}
+}
+
+static void connected(struct bt_conn *conn, uint8_t conn_err)
+{
+	struct bt_conn_info info;
+	struct nus_link *link;
+	int err;
+
+	if (bt_conn_get_info(conn, &info) || (info.role != BT_CONN_ROLE_CENTRAL)) {
+		return;
+	}
+
+	if (conn_err) {
+		LOG_WRN("Connection to NUS peer failed (err 0x%02x)", conn_err);
+		scan_resume();
+		return;
+	}
+
+	link = link_get(NULL);
+	if (!link) {
+		bt_conn_disconnect(conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+		return;
+	}
+
+	link->conn = bt_conn_ref(conn);
+	link->ready = false;
+	tx_flush(link);
+
+	link->mtu_params.func = mtu_exchanged;
+	err = bt_gatt_exchange_mtu(conn, &link->mtu_params);
+	if (err) {
+		LOG_WRN("MTU exchange failed (err %d)", err);
+		mtu_exchanged(conn, 0, &link->mtu_params);
+	}
+
+	scan_resume();
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	struct nus_link *link = link_get(conn);
+
+	if (!link) {
+		return;
+	}
+
+	LOG_INF("NUS peer %u disconnected (reason 0x%02x)", link_id(link), reason);
+
+	if (link->ready) {
+		link->ready = false;
+		atomic_dec(&ready_count);
+
+		if (central_cb->disconnected) {
+			central_cb->disconnected(link_id(link));
+		}
+	}
+
+	bt_conn_unref(link->conn);
+	link->conn = NULL;
+
+	/* Queued data is for this peer only, drop it with the link. */
+	tx_flush(link);
+
+	scan_resume();
+}
+
+BT_CONN_CB_DEFINE(nus_central_conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+};
+
+static void scan_filter_match(struct bt_scan_device_info *device_info,
+			      struct bt_scan_filter_match *filter_match, bool connectable)
+{
+	char addr[BT_ADDR_LE_STR_LEN];
+
+	bt_addr_le_to_str(device_info->recv_info->addr, addr, sizeof(addr));
+	LOG_INF("NUS peer found %s", addr);
+}
+
+static void scan_connecting_error(struct bt_scan_device_info *device_info)
+{
+	LOG_WRN("Connecting to NUS peer failed");
+	scan_resume();
+}
+
+BT_SCAN_CB_INIT(scan_cb, scan_filter_match, NULL, scan_connecting_error, NULL);
+
+int nus_central_send(uint8_t id, const uint8_t *data, uint16_t len)
+{
+	struct nus_link *link;
+	k_spinlock_key_t key;
+	int err = 0;
+
+	if ((id >= ARRAY_SIZE(links)) || !links[id].ready) {
+		return -ENOTCONN;
+	}
+
+	link = &links[id];
+
+	if (len > nus_central_max_payload(id)) {
+		return -EMSGSIZE;
+	}
+
+	/* Queue the data instead of waiting for the previous write, so that
+	 * a slow peer only loses its own data.
+	 */
+	key = k_spin_lock(&lock);
+
+	if (ring_buf_space_get(&link->tx_ring) < (sizeof(len) + len)) {
+		err = -ENOMEM;
+	} else {
+		ring_buf_put(&link->tx_ring, (const uint8_t *)&len, sizeof(len));
+		ring_buf_put(&link->tx_ring, data, len);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (!err) {
+		k_work_submit(&link->tx_work);
+	}
+
+	return err;
+}
+
+uint16_t nus_central_max_payload(uint8_t id)
+{
+	if ((id >= ARRAY_SIZE(links)) || !links[id].ready) {
+		return 0;
+	}
+
+	return MIN(bt_gatt_get_mtu(links[id].conn) - ATT_WRITE_OVERHEAD, WRITE_MAX_LEN);
+}
+
+uint8_t nus_central_count(void)
+{
+	return atomic_get(&ready_count);
+}
+
+int nus_central_init(const struct nus_central_cb *cb)
+{
+	struct bt_scan_init_param scan_init = {
+		.connect_if_match = true,
+	};
+	struct bt_nus_client_init_param client_init = {
+		.cb = {
+			.received = client_received,
+			.sent = client_sent,
+		},
+	};
+	int err;
+
+	central_cb = cb;
+
+	for (size_t i = 0; i < ARRAY_SIZE(links); i++) {
+		ring_buf_init(&links[i].tx_ring, sizeof(links[i].tx_ring_data),
+			      links[i].tx_ring_data);
+		k_work_init(&links[i].tx_work, tx_work_handler);
+
+		err = bt_nus_client_init(&links[i].client, &client_init);
+		if (err) {
+			LOG_ERR("Cannot initialize NUS client (err %d)", err);
+			return err;
+		}
+	}
+
+	bt_scan_init(&scan_init);
+	bt_scan_cb_register(&scan_cb);
+
+	if (sizeof(CONFIG_BT_NUS_CENTRAL_PEER_NAME) > 1) {
+		/* Peers that all advertise the service, as in a relay chain,
+		 * are told apart by their name.
+		 */
+		err = bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, CONFIG_BT_NUS_CENTRAL_PEER_NAME);
+	} else {
+		err = bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, BT_UUID_NUS_SERVICE);
+	}
+
+	if (err) {
+		LOG_ERR("Cannot set scanning filter (err %d)", err);
+		return err;
+	}
+
+	err = bt_scan_filter_enable((sizeof(CONFIG_BT_NUS_CENTRAL_PEER_NAME) > 1) ?
+				    BT_SCAN_NAME_FILTER : BT_SCAN_UUID_FILTER, false);
+	if (err) {
+		LOG_ERR("Cannot enable scanning filter (err %d)", err);
+		return err;
+	}
+
+	scan_resume();
+
+	return 0;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef NUS_CENTRAL_H_
+#define NUS_CENTRAL_H_
+
+/** @file
+ *  @brief NUS central links
+ *
+ *  Scans for peripherals advertising the Nordic UART Service, connects to
+ *  them, discovers and subscribes to their service, and exchanges data
+ *  with them. Each link is identified by the index of its slot.
+ */
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Link events reported to the user of the central links. */
+struct nus_central_cb {
+	/** @brief Link ready, the NUS service of the peer was subscribed to.
+	 *
+	 *  @param id Link identifier.
+	 */
+	void (*ready)(uint8_t id);
+
+	/** @brief Link lost.
+	 *
+	 *  @param id Link identifier.
+	 */
+	void (*disconnected)(uint8_t id);
+
+	/** @brief Data notified by the peer.
+	 *
+	 *  Called from the Bluetooth receive context.
+	 *
+	 *  @param id   Link identifier.
+	 *  @param data Notified data.
+	 *  @param len  Data length.
+	 */
+	void (*received)(uint8_t id, const uint8_t *data, uint16_t len);
+};
+
+/** @brief Start scanning for NUS peripherals.
+ *
+ *  Scanning stops while all link slots are in use, and resumes when a link
+ *  is lost.
+ *
+ *  @param cb Link event callbacks.
+ *
+ *  @return 0 on success, negative error code otherwise.
+ */
+int nus_central_init(const struct nus_central_cb *cb);
+
+/** @brief Send data to a peer.
+ *
+ *  @param id   Link identifier.
+ *  @param data Data to send, not longer than nus_central_max_payload().
+ *  @param len  Data length.
+ *
+ *  The data is queued for the peer and written from the system work queue,
+ *  without waiting for the previous write to complete.
+ *
+ *  @retval 0 on success.
+ *  @retval -ENOTCONN if the link is not ready.
+ *  @retval -EMSGSIZE if the data does not fit the link MTU.
+ *  @retval -ENOMEM if the queue of the peer is full.
+ */
+int nus_central_send(uint8_t id, const uint8_t *data, uint16_t len);
+
+/** @brief Get the largest data sent in one write to a peer.
+ *
+ *  @param id Link identifier.
+ *
+ *  @return Payload limit in bytes, 0 if the link is not ready.
+ */
+uint16_t nus_central_max_payload(uint8_t id);
+
+/** @brief Get the number of ready links.
+ *
+ *  @return Number of links.
+ */
+uint8_t nus_central_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NUS_CENTRAL_H_ */
@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/hci.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <zephyr/logging/log.h>
+
+#include "bridge_stats.h"
+#include "conn_evt.h"
+#include "phy_mgr.h"
+
+LOG_MODULE_DECLARE(peripheral_uart);
+
+enum phy_level {
+	PHY_LEVEL_2M,
+	PHY_LEVEL_1M,
+	PHY_LEVEL_CODED_S2,
+	PHY_LEVEL_CODED_S8,
+};
+
+struct phy_level_desc {
+	const char *name;
+	struct bt_conn_le_phy_param param;
+	/* Largest notification payload, 0 for no limit. A bit error costs the
+	 * retransmission of the whole PDU, which lasts up to 17 ms on Coded
+	 * S8, so keep PDUs short on the coded PHYs.
+	 */
+	size_t max_payload;
+};
+
+static const struct phy_level_desc levels[] = {
+	[PHY_LEVEL_2M] = {
+		.name = "2M",
+		.param = {
+			.options = BT_CONN_LE_PHY_OPT_NONE,
+			.pref_tx_phy = BT_GAP_LE_PHY_2M,
+			.pref_rx_phy = BT_GAP_LE_PHY_2M,
+		},
+	},
+	[PHY_LEVEL_1M] = {
+		.name = "1M",
+		.param = {
+			.options = BT_CONN_LE_PHY_OPT_NONE,
+			.pref_tx_phy = BT_GAP_LE_PHY_1M,
+			.pref_rx_phy = BT_GAP_LE_PHY_1M,
+		},
+	},
+	[PHY_LEVEL_CODED_S2] = {
+		.name = "Coded S2",
+		.param = {
+			.options = BT_CONN_LE_PHY_OPT_CODED_S2,
+			.pref_tx_phy = BT_GAP_LE_PHY_CODED,
+			.pref_rx_phy = BT_GAP_LE_PHY_CODED,
+		},
+		.max_payload = 120,
+	},
+	[PHY_LEVEL_CODED_S8] = {
+		.name = "Coded S8",
+		.param = {
+			.options = BT_CONN_LE_PHY_OPT_CODED_S8,
+			.pref_tx_phy = BT_GAP_LE_PHY_CODED,
+			.pref_rx_phy = BT_GAP_LE_PHY_CODED,
+		},
+		.max_payload = 60,
+	},
+};
+
+#define PHY_LEVEL_MAX \
+	(IS_ENABLED(CONFIG_BT_NUS_PHY_ADAPTIVE_CODED) ? PHY_LEVEL_CODED_S8 : PHY_LEVEL_1M)
+
+/* Followed link. The work handler takes its own reference under conn_lock
+ * since it blocks on HCI commands, during which the link may disconnect.
+ */
+static struct bt_conn *conn;
+static struct k_spinlock conn_lock;
+static struct k_work_delayable phy_work;
+
+static enum phy_level active;
+static enum phy_level requested;
+static uint8_t bad_periods;
+static uint8_t good_periods;
+static uint8_t pending_periods;
+/* RSSI average, in 1/16 dBm, valid once has_sample is set. */
+static int32_t rssi_avg;
+static bool has_sample;
+static struct conn_evt_counters last;
+static uint32_t last_tx_bytes;
+static int64_t last_uptime;
+
+static int read_rssi(struct bt_conn *conn, int8_t *rssi)
+{
+	struct bt_hci_cp_read_rssi *cp;
+	struct bt_hci_rp_read_rssi *rp;
+	struct net_buf *buf;
+	struct net_buf *rsp = NULL;
+	uint16_t handle;
+	int err;
+
+	err = bt_hci_get_conn_handle(conn, &handle);
+	if (err) {
+		return err;
+	}
+
+	buf = bt_hci_cmd_create(BT_HCI_OP_READ_RSSI, sizeof(*cp));
+	if (!buf) {
+		return -ENOBUFS;
+	}
+
+	cp = net_buf_add(buf, sizeof(*cp));
+	cp->handle = sys_cpu_to_le16(handle);
+
+	err = bt_hci_cmd_send_sync(BT_HCI_OP_READ_RSSI, buf, &rsp);
+	if (err) {
+		return err;
+	}
+
+	rp = (void *)rsp->data;
+	*rssi = rp->rssi;
+	net_buf_unref(rsp);
+
+	return 0;
+}
+
+static uint32_t error_pct(uint32_t errors, uint32_t total)
+{
+	return total ? (100 * (uint64_t)MIN(errors, total) / total) : 0;
+}
+
+static void phy_request(struct bt_conn *link, enum phy_level level)
+{
+	int err;
+
+	err = bt_conn_le_phy_update(link, &levels[level].param);
+	if (err) {
+		LOG_WRN("PHY update to %s failed (err %d)", levels[level].name, err);
+		return;
+	}
+
+	requested = level;
+	pending_periods = 0;
+	bad_periods = 0;
+	good_periods = 0;
+}
+
+static struct bt_conn *conn_get(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&conn_lock);
+	struct bt_conn *link = conn ? bt_conn_ref(conn) : NULL;
+
+	k_spin_unlock(&conn_lock, key);
+
+	return link;
+}
+
+static bool conn_is(struct bt_conn *link)
+{
+	k_spinlock_key_t key = k_spin_lock(&conn_lock);
+	bool same = (conn == link);
+
+	k_spin_unlock(&conn_lock, key);
+
+	return same;
+}
+
+static void phy_evaluate(struct bt_conn *link)
+{
+	struct conn_evt_counters now;
+	uint32_t err_pct;
+	uint32_t goodput;
+	int64_t uptime;
+	int8_t rssi;
+	bool bad;
+	bool good;
+
+	if (!read_rssi(link, &rssi) && (rssi != BT_HCI_LE_RSSI_NOT_AVAILABLE)) {
+		rssi_avg = has_sample ? (rssi_avg * 3 + rssi * 16) / 4 : rssi * 16;
+		has_sample = true;
+	}
+
+	/* Rate of the worst direction: CRC errors out of the received
+	 * packets and NAKs out of the transmitted ones.
+	 */
+	conn_evt_counters_get(link, &now);
+	err_pct = MAX(error_pct(now.crc_errors - last.crc_errors,
+				(now.rx_pkts - last.rx_pkts) + (now.crc_errors - last.crc_errors)),
+		      error_pct(now.naks - last.naks, now.tx_pkts - last.tx_pkts));
+	/* Disconnected while reading the RSSI, the state was reset. */
+	if (!conn_is(link)) {
+		return;
+	}
+
+	last = now;
+
+	uptime = k_uptime_get();
+	goodput = (uint32_t)MIN((uint64_t)(bridge_stats.ble_tx_bytes - last_tx_bytes) * 8 *
+				MSEC_PER_SEC / MAX(uptime - last_uptime, 1), UINT32_MAX);
+	last_tx_bytes = bridge_stats.ble_tx_bytes;
+	last_uptime = uptime;
+
+	BRIDGE_STATS_SET(phy_level, active);
+	BRIDGE_STATS_SET(phy_rssi_neg, -rssi_avg / 16);
+	BRIDGE_STATS_SET(phy_err_pct, err_pct);
+	BRIDGE_STATS_SET(phy_goodput_bps, goodput);
+
+	if (requested != active) {
+		/* Give the pending update one period to complete, the peer
+		 * may keep the current PHY without reporting an update.
+		 */
+		if (++pending_periods <= 1) {
+			return;
+		}
+
+		requested = active;
+	}
+
+	bad = (has_sample && (rssi_avg < CONFIG_BT_NUS_PHY_ADAPTIVE_RSSI_LOW * 16)) ||
+	      (err_pct > CONFIG_BT_NUS_PHY_ADAPTIVE_ERR_HIGH);
+	good = has_sample && (rssi_avg > CONFIG_BT_NUS_PHY_ADAPTIVE_RSSI_HIGH * 16) &&
+	       (err_pct < CONFIG_BT_NUS_PHY_ADAPTIVE_ERR_LOW);
+
+	bad_periods = bad ? (bad_periods + 1) : 0;
+	good_periods = good ? MIN(good_periods + 1, UINT8_MAX) : 0;
+
+	if ((bad_periods >= CONFIG_BT_NUS_PHY_ADAPTIVE_DOWN_PERIODS) && (active < PHY_LEVEL_MAX)) {
+		LOG_INF("Link degraded (RSSI %d dBm, errors %u%%, goodput %u bps), moving to %s",
+			rssi_avg / 16, err_pct, goodput, levels[active + 1].name);
+		phy_request(link, active + 1);
+	} else if ((good_periods >= CONFIG_BT_NUS_PHY_ADAPTIVE_UP_PERIODS) &&
+		   (active > PHY_LEVEL_2M)) {
+		LOG_INF("Link improved (RSSI %d dBm, errors %u%%, goodput %u bps), moving to %s",
+			rssi_avg / 16, err_pct, goodput, levels[active - 1].name);
+		phy_request(link, active - 1);
+	}
+}
+
+static void phy_work_handler(struct k_work *work)
+{
+	struct bt_conn *link = conn_get();
+
+	if (!link) {
+		return;
+	}
+
+	k_work_reschedule(&phy_work, K_MSEC(CONFIG_BT_NUS_PHY_ADAPTIVE_PERIOD));
+
+	phy_evaluate(link);
+	bt_conn_unref(link);
+}
+
+size_t phy_mgr_max_payload(void)
+{
+	return levels[active].max_payload ? levels[active].max_payload : SIZE_MAX;
+}
+
+static void connected(struct bt_conn *new_conn, uint8_t err)
+{
+	struct bt_conn_info info;
+	k_spinlock_key_t key;
+
+	if (err || conn) {
+		return;
+	}
+
+	/* Follow the NUS link, on which the central writes to the bridge.
+	 * Central links of the gateway are left to their default PHY.
+	 */
+	if (IS_ENABLED(CONFIG_BT_CENTRAL) &&
+	    (bt_conn_get_info(new_conn, &info) || (info.role != BT_CONN_ROLE_PERIPHERAL))) {
+		return;
+	}
+
+	key = k_spin_lock(&conn_lock);
+	conn = bt_conn_ref(new_conn);
+	k_spin_unlock(&conn_lock, key);
+
+	active = PHY_LEVEL_1M;
+	rssi_avg = 0;
+	has_sample = false;
+	conn_evt_counters_get(new_conn, &last);
+	last_tx_bytes = bridge_stats.ble_tx_bytes;
+	last_uptime = k_uptime_get();
+
+	/* Start at the fastest PHY and let the link quality move it down. */
+	phy_request(new_conn, PHY_LEVEL_2M);
+
+	k_work_reschedule(&phy_work, K_MSEC(CONFIG_BT_NUS_PHY_ADAPTIVE_PERIOD));
+}
+
+static void disconnected(struct bt_conn *old_conn, uint8_t reason)
+{
+	k_spinlock_key_t key;
+
+	if (old_conn != conn) {
+		return;
+	}
+
+	key = k_spin_lock(&conn_lock);
+	conn = NULL;
+	k_spin_unlock(&conn_lock, key);
+
+	/* A running handler keeps its own reference and sees the link gone. */
+	k_work_cancel_delayable(&phy_work);
+	bt_conn_unref(old_conn);
+	active = PHY_LEVEL_2M;
+	requested = PHY_LEVEL_2M;
+}
+
+static void le_phy_updated(struct bt_conn *phy_conn, struct bt_conn_le_phy_info *param)
+{
+	if (phy_conn != conn) {
+		return;
+	}
+
+	switch (param->tx_phy) {
+	case BT_GAP_LE_PHY_2M:
+		active = PHY_LEVEL_2M;
+		break;
+	case BT_GAP_LE_PHY_CODED:
+		/* The coding is not reported, assume the requested one. */
+		active = (requested >= PHY_LEVEL_CODED_S2) ? requested : PHY_LEVEL_CODED_S8;
+		break;
+	default:
+		active = PHY_LEVEL_1M;
+		break;
+	}
+
+	/* The peer may not support the requested PHY. */
+	requested = active;
+
+	BRIDGE_STATS_INC(phy_switches);
+	LOG_INF("PHY updated to %s", levels[active].name);
+}
+
+BT_CONN_CB_DEFINE(phy_mgr_conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+	.le_phy_updated = le_phy_updated,
+};
+
+static int phy_mgr_sys_init(void)
+{
+	k_work_init_delayable(&phy_work, phy_work_handler);
+
+	return 0;
+}
+
+SYS_INIT(phy_mgr_sys_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef PHY_MGR_H_
+#define PHY_MGR_H_
+
+/** @file
+ *  @brief Adaptive PHY selection
+ *
+ *  Moves the connection along the 2M, 1M, Coded S2 and Coded S8 PHYs
+ *  according to the RSSI, CRC errors and retransmissions of the link, with
+ *  hysteresis, and limits the notification size on the slower PHYs.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CONFIG_BT_NUS_PHY_ADAPTIVE)
+
+/** @brief Get the largest notification payload for the current PHY.
+ *
+ *  @return Payload limit in bytes.
+ */
+size_t phy_mgr_max_payload(void);
+
+#else
+
+static inline size_t phy_mgr_max_payload(void)
+{
+	return SIZE_MAX;
+}
+
+#endif /* CONFIG_BT_NUS_PHY_ADAPTIVE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PHY_MGR_H_ */
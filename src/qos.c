@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/mgmt/mcumgr/mgmt/callbacks.h>
+#include <zephyr/mgmt/mcumgr/grp/img_mgmt/img_mgmt.h>
+
+#include <zephyr/logging/log.h>
+
+#include "bridge_stats.h"
+#include "qos.h"
+
+LOG_MODULE_DECLARE(peripheral_uart);
+
+/* A service is considered idle when it did not move data for this long. */
+#define NUS_IDLE_TIMEOUT_MS 500
+#define DFU_IDLE_TIMEOUT_MS 2000
+
+/* Poll period used when the throttled service has no bandwidth share. */
+#define PAUSED_POLL_MS 10
+
+#define QOS_RATE(share) ((uint32_t)((uint64_t)CONFIG_BT_NUS_QOS_LINK_BUDGET * (share) / 100))
+
+struct qos_bucket {
+	/* Refill rate in bytes per second. */
+	uint32_t rate;
+	/* Tokens and capacity are kept in millibytes so that short refill
+	 * intervals are not lost to rounding.
+	 */
+	uint64_t capacity;
+	uint64_t tokens;
+	int64_t last_refill;
+};
+
+struct dfu_rate {
+	uint32_t bytes;
+	uint32_t ms;
+};
+
+/* Protects the buckets, used from the NUS thread and the SMP thread. */
+static struct k_spinlock lock;
+static struct qos_bucket nus_bucket;
+static struct qos_bucket dfu_bucket;
+
+static atomic_t dfu_active;
+/* 32-bit uptimes, 0 until the first chunk or notification. */
+static atomic_t dfu_last_chunk;
+static atomic_t nus_last_send;
+
+static struct dfu_rate dfu_alone;
+static struct dfu_rate dfu_shared;
+
+static void bucket_init(struct qos_bucket *bucket, uint32_t rate)
+{
+	bucket->rate = rate;
+	/* Allow bursts of 100 ms worth of data, at least one UART buffer. */
+	bucket->capacity = MAX((uint64_t)rate * 100, CONFIG_BT_NUS_UART_BUFFER_SIZE * 1000ULL);
+	bucket->tokens = bucket->capacity;
+	bucket->last_refill = k_uptime_get();
+}
+
+static void bucket_refill(struct qos_bucket *bucket)
+{
+	int64_t now = k_uptime_get();
+
+	bucket->tokens = MIN(bucket->capacity,
+			     bucket->tokens + (uint64_t)bucket->rate * (now - bucket->last_refill));
+	bucket->last_refill = now;
+}
+
+/* Take the tokens for len bytes if available or if the bucket is not
+ * contended. Otherwise, return the time in milliseconds until they are.
+ */
+static uint32_t bucket_take(struct qos_bucket *bucket, size_t len, bool contended)
+{
+	uint64_t needed = MIN((uint64_t)len * 1000, bucket->capacity);
+	uint32_t wait_ms = 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	bucket_refill(bucket);
+
+	if (!contended || (bucket->tokens >= needed)) {
+		bucket->tokens -= MIN(bucket->tokens, needed);
+	} else if (bucket->rate == 0) {
+		wait_ms = PAUSED_POLL_MS;
+	} else {
+		wait_ms = DIV_ROUND_UP(needed - bucket->tokens, bucket->rate);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return wait_ms;
+}
+
+static bool recently(const atomic_t *timestamp, uint32_t timeout_ms)
+{
+	uint32_t at = atomic_get(timestamp);
+
+	return at && ((k_uptime_get_32() - at) < timeout_ms);
+}
+
+static bool dfu_is_active(void)
+{
+	return atomic_get(&dfu_active) && recently(&dfu_last_chunk, DFU_IDLE_TIMEOUT_MS);
+}
+
+static bool nus_is_active(void)
+{
+	return recently(&nus_last_send, NUS_IDLE_TIMEOUT_MS);
+}
+
+static uint32_t dfu_rate_bps(const struct dfu_rate *rate)
+{
+	return rate->ms ? (uint32_t)((uint64_t)rate->bytes * MSEC_PER_SEC / rate->ms) : 0;
+}
+
+static void dfu_start(void)
+{
+	memset(&dfu_alone, 0, sizeof(dfu_alone));
+	memset(&dfu_shared, 0, sizeof(dfu_shared));
+
+	atomic_set(&dfu_last_chunk, k_uptime_get_32());
+	atomic_set(&dfu_active, true);
+
+	LOG_INF("DFU upload started, NUS data %s", IS_ENABLED(CONFIG_BT_NUS_QOS_PRIORITY_DFU) ?
+		"throttled" : "has priority");
+}
+
+static void dfu_stop(void)
+{
+	uint32_t alone_bps = dfu_rate_bps(&dfu_alone);
+	uint32_t shared_bps = dfu_rate_bps(&dfu_shared);
+
+	if (!atomic_cas(&dfu_active, true, false)) {
+		return;
+	}
+
+	LOG_INF("DFU throughput: %u B/s alone, %u B/s with concurrent NUS data",
+		alone_bps, shared_bps);
+
+	BRIDGE_STATS_SET(dfu_bps_alone, alone_bps);
+	BRIDGE_STATS_SET(dfu_bps_shared, shared_bps);
+}
+
+/* Clients end the upload on an error, so chunks beyond the DFU share are
+ * never rejected. Runs in the SMP work queue, which holds the response,
+ * and with it the next chunk of the client, until the chunk's turn.
+ */
+static void dfu_chunk(size_t len)
+{
+	bool nus_active = nus_is_active();
+	struct dfu_rate *rate = nus_active ? &dfu_shared : &dfu_alone;
+	uint32_t now;
+
+	if (IS_ENABLED(CONFIG_BT_NUS_QOS_PRIORITY_NUS)) {
+		int64_t start = k_uptime_get();
+		uint32_t waited_ms = 0;
+		uint32_t wait_ms;
+
+		/* Past the longest delay, the chunk goes through anyway
+		 * before the client gives up on the response.
+		 */
+		while ((waited_ms < CONFIG_BT_NUS_QOS_DFU_MAX_DELAY) &&
+		       (wait_ms = bucket_take(&dfu_bucket, len, nus_is_active()))) {
+			k_sleep(K_MSEC(MIN(wait_ms, CONFIG_BT_NUS_QOS_DFU_MAX_DELAY - waited_ms)));
+			waited_ms = k_uptime_get() - start;
+		}
+
+		BRIDGE_STATS_INCN(qos_dfu_wait_ms, waited_ms);
+	}
+
+	now = k_uptime_get_32();
+
+	if (!atomic_get(&dfu_active)) {
+		dfu_start();
+	} else {
+		rate->bytes += len;
+		rate->ms += now - (uint32_t)atomic_get(&dfu_last_chunk);
+	}
+
+	atomic_set(&dfu_last_chunk, now);
+}
+
+static enum mgmt_cb_return img_mgmt_event(uint32_t event, enum mgmt_cb_return prev_status,
+					  int32_t *rc, uint16_t *group, bool *abort_more,
+					  void *data, size_t data_size)
+{
+	const struct img_mgmt_upload_check *check;
+
+	switch (event) {
+	case MGMT_EVT_OP_IMG_MGMT_DFU_STARTED:
+		dfu_start();
+		break;
+
+	case MGMT_EVT_OP_IMG_MGMT_DFU_CHUNK:
+		check = data;
+		dfu_chunk(check->req->img_data.len);
+		break;
+
+	case MGMT_EVT_OP_IMG_MGMT_DFU_STOPPED:
+	case MGMT_EVT_OP_IMG_MGMT_DFU_PENDING:
+		dfu_stop();
+		break;
+
+	default:
+		break;
+	}
+
+	return MGMT_CB_OK;
+}
+
+static struct mgmt_callback img_mgmt_cb = {
+	.callback = img_mgmt_event,
+	.event_id = MGMT_EVT_OP_IMG_MGMT_ALL,
+};
+
+int qos_init(void)
+{
+	bucket_init(&nus_bucket, QOS_RATE(CONFIG_BT_NUS_QOS_NUS_SHARE));
+	bucket_init(&dfu_bucket, QOS_RATE(CONFIG_BT_NUS_QOS_DFU_SHARE));
+
+	mgmt_callback_register(&img_mgmt_cb);
+
+	return 0;
+}
+
+void qos_nus_acquire(size_t len)
+{
+	if (IS_ENABLED(CONFIG_BT_NUS_QOS_PRIORITY_DFU)) {
+		int64_t start = k_uptime_get();
+		uint32_t wait_ms;
+
+		/* Runs in the NUS thread, which can sleep until its turn. */
+		while ((wait_ms = bucket_take(&nus_bucket, len, dfu_is_active()))) {
+			k_sleep(K_MSEC(wait_ms));
+		}
+
+		BRIDGE_STATS_INCN(qos_nus_wait_ms, k_uptime_get() - start);
+	}
+
+	atomic_set(&nus_last_send, k_uptime_get_32());
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef QOS_H_
+#define QOS_H_
+
+/** @file
+ *  @brief Bandwidth arbitration between NUS data and SMP DFU traffic
+ *
+ *  Both services share the same connection and ATT buffers. While the
+ *  service with priority is active, the other one is limited to its
+ *  configured share of the link budget by a token bucket.
+ */
+
+#include <stddef.h>
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CONFIG_BT_NUS_QOS)
+
+/** @brief Register the MCUmgr image management callbacks.
+ *
+ *  @return 0 on success, negative error code otherwise.
+ */
+int qos_init(void);
+
+/** @brief Wait until NUS is allowed to send data.
+ *
+ *  Blocks the caller while a DFU upload with priority is active and the NUS
+ *  share of the link budget is used up.
+ *
+ *  @param len Number of bytes about to be sent.
+ */
+void qos_nus_acquire(size_t len);
+
+#else
+
+static inline int qos_init(void)
+{
+	return 0;
+}
+
+static inline void qos_nus_acquire(size_t len)
+{
+	ARG_UNUSED(len);
+}
+
+#endif /* CONFIG_BT_NUS_QOS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* QOS_H_ */
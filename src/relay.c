@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/sys/atomic.h>
+
+#include <bluetooth/services/nus.h>
+
+#include <zephyr/logging/log.h>
+
+#include "bridge_stats.h"
+#include "nus_central.h"
+#include "relay.h"
+
+LOG_MODULE_DECLARE(peripheral_uart);
+
+/* Link of the upstream bridge. */
+#define UPSTREAM_ID 0
+
+enum relay_dir {
+	RELAY_DOWNSTREAM,
+	RELAY_UPSTREAM,
+};
+
+struct relay_meta {
+	uint32_t rx_cycles;
+	uint8_t dir;
+};
+
+NET_BUF_POOL_FIXED_DEFINE(relay_pool, CONFIG_BT_NUS_RELAY_BUF_COUNT,
+			  CONFIG_BT_NUS_RELAY_BUF_SIZE, sizeof(struct relay_meta), NULL);
+
+static K_FIFO_DEFINE(relay_fifo);
+
+/* Central connected to the local NUS service, changed with lock held. */
+static struct bt_conn *downstream_conn;
+static struct k_spinlock lock;
+
+static atomic_t bytes[2];
+static atomic_t lat_sum_us;
+static atomic_t lat_cnt;
+static struct k_work_delayable report_work;
+
+/* Data is copied once out of the received ATT PDU, into a relay buffer
+ * that is handed over to the relay thread and sent from there, out of the
+ * Bluetooth receive context.
+ */
+static void relay_put(enum relay_dir dir, const uint8_t *data, uint16_t len)
+{
+	struct relay_meta *meta;
+	struct net_buf *buf;
+
+	if ((len > CONFIG_BT_NUS_RELAY_BUF_SIZE) ||
+	    (IS_ENABLED(CONFIG_BT_NUS_RELAY_TRACE) && (len < sizeof(struct relay_trace_hdr)))) {
+		BRIDGE_STATS_INCN(relay_drop, len);
+		return;
+	}
+
+	buf = net_buf_alloc(&relay_pool, K_NO_WAIT);
+	if (!buf) {
+		BRIDGE_STATS_INCN(relay_drop, len);
+		return;
+	}
+
+	meta = net_buf_user_data(buf);
+	meta->rx_cycles = k_cycle_get_32();
+	meta->dir = dir;
+	net_buf_add_mem(buf, data, len);
+
+	if (IS_ENABLED(CONFIG_BT_NUS_RELAY_TRACE)) {
+		struct relay_trace_hdr *hdr = (void *)buf->data;
+
+		hdr->hops++;
+		relay_trace_account(hdr, len - sizeof(*hdr));
+	}
+
+	k_fifo_put(&relay_fifo, buf);
+}
+
+static void upstream_received(uint8_t id, const uint8_t *data, uint16_t len)
+{
+	relay_put(RELAY_DOWNSTREAM, data, len);
+}
+
+void relay_downstream_received(const uint8_t *data, uint16_t len)
+{
+	relay_put(RELAY_UPSTREAM, data, len);
+}
+
+/* Reference to the downstream link, to be released by the caller. */
+static struct bt_conn *downstream_get(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct bt_conn *conn = downstream_conn ? bt_conn_ref(downstream_conn) : NULL;
+
+	k_spin_unlock(&lock, key);
+
+	return conn;
+}
+
+static int downstream_send(const uint8_t *data, uint16_t len)
+{
+	struct bt_conn *conn = downstream_get();
+	int err;
+
+	if (!conn) {
+		return -ENOTCONN;
+	}
+
+	err = bt_nus_send(conn, data, len);
+	bt_conn_unref(conn);
+
+	return err;
+}
+
+static void relay_thread(void)
+{
+	for (;;) {
+		struct net_buf *buf = k_fifo_get(&relay_fifo, K_FOREVER);
+		struct relay_meta *meta = net_buf_user_data(buf);
+		uint32_t lat_us;
+		int err;
+
+		if (meta->dir == RELAY_DOWNSTREAM) {
+			err = downstream_send(buf->data, buf->len);
+		} else {
+			err = nus_central_send(UPSTREAM_ID, buf->data, buf->len);
+		}
+
+		if (err) {
+			LOG_WRN("Cannot relay %s (err %d)",
+				(meta->dir == RELAY_DOWNSTREAM) ? "downstream" : "upstream", err);
+			BRIDGE_STATS_INCN(relay_drop, buf->len);
+		} else {
+			lat_us = k_cyc_to_us_floor32(k_cycle_get_32() - meta->rx_cycles);
+			atomic_add(&lat_sum_us, lat_us);
+			atomic_inc(&lat_cnt);
+			BRIDGE_STATS_SET(relay_lat_max_us, MAX(bridge_stats.relay_lat_max_us, lat_us));
+			atomic_add(&bytes[meta->dir], buf->len);
+		}
+
+		net_buf_unref(buf);
+	}
+}
+
+K_THREAD_DEFINE(relay_thread_id, CONFIG_BT_NUS_THREAD_STACK_SIZE, relay_thread, NULL, NULL,
+		NULL, 7, 0, 0);
+
+static void report_work_handler(struct k_work *work)
+{
+	uint32_t down_bps = (uint64_t)atomic_clear(&bytes[RELAY_DOWNSTREAM]) * 8 * MSEC_PER_SEC /
+			    CONFIG_BT_NUS_RELAY_REPORT_INTERVAL;
+	uint32_t up_bps = (uint64_t)atomic_clear(&bytes[RELAY_UPSTREAM]) * 8 * MSEC_PER_SEC /
+			  CONFIG_BT_NUS_RELAY_REPORT_INTERVAL;
+	uint32_t lat_sum = atomic_clear(&lat_sum_us);
+	uint32_t lat_n = atomic_clear(&lat_cnt);
+	uint32_t lat_avg_us = lat_n ? (lat_sum / lat_n) : 0;
+
+	BRIDGE_STATS_SET(relay_down_bps, down_bps);
+	BRIDGE_STATS_SET(relay_up_bps, up_bps);
+	BRIDGE_STATS_SET(relay_lat_us, lat_avg_us);
+
+	LOG_INF("Relay: down %u bps, up %u bps, hop latency %u us (max %u us)", down_bps, up_bps,
+		lat_avg_us, bridge_stats.relay_lat_max_us);
+
+	k_work_reschedule(&report_work, K_MSEC(CONFIG_BT_NUS_RELAY_REPORT_INTERVAL));
+}
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	struct bt_conn_info info;
+	k_spinlock_key_t key;
+
+	if (err || bt_conn_get_info(conn, &info) || (info.role != BT_CONN_ROLE_PERIPHERAL)) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (!downstream_conn) {
+		downstream_conn = bt_conn_ref(conn);
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	bool match = (conn == downstream_conn);
+
+	if (match) {
+		downstream_conn = NULL;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (match) {
+		bt_conn_unref(conn);
+	}
+}
+
+BT_CONN_CB_DEFINE(relay_conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+};
+
+static const struct nus_central_cb central_cb = {
+	.received = upstream_received,
+};
+
+int relay_init(void)
+{
+	int err;
+
+	err = nus_central_init(&central_cb);
+	if (err) {
+		return err;
+	}
+
+	k_work_init_delayable(&report_work, report_work_handler);
+	k_work_reschedule(&report_work, K_MSEC(CONFIG_BT_NUS_RELAY_REPORT_INTERVAL));
+
+	return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef RELAY_H_
+#define RELAY_H_
+
+/** @file
+ *  @brief NUS relay
+ *
+ *  Forwards data between the upstream bridge, reached through a central
+ *  link, and the downstream bridge connected to the local NUS service, so
+ *  that the stream can hop across a chain of bridges.
+ */
+
+#include <stddef.h>
+#include <zephyr/types.h>
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Trace header in front of the data of each notification and write when
+ *  CONFIG_BT_NUS_RELAY_TRACE is enabled.
+ */
+struct relay_trace_hdr {
+	/** Uptime of the originating bridge when it sent the data, in
+	 *  microseconds, little endian.
+	 */
+	uint32_t origin_us;
+	/** Number of relays the data went through. */
+	uint8_t hops;
+} __packed;
+
+#if defined(CONFIG_BT_NUS_RELAY_TRACE)
+
+/** @brief Fill the trace header of data originated by this bridge.
+ *
+ *  @param hdr Trace header.
+ */
+void relay_trace_stamp(struct relay_trace_hdr *hdr);
+
+/** @brief Account data received with a trace header.
+ *
+ *  @param hdr Trace header.
+ *  @param len Length of the data following the header.
+ */
+void relay_trace_account(const struct relay_trace_hdr *hdr, size_t len);
+
+#else
+
+static inline void relay_trace_stamp(struct relay_trace_hdr *hdr)
+{
+	ARG_UNUSED(hdr);
+}
+
+static inline void relay_trace_account(const struct relay_trace_hdr *hdr, size_t len)
+{
+	ARG_UNUSED(hdr);
+	ARG_UNUSED(len);
+}
+
+#endif /* CONFIG_BT_NUS_RELAY_TRACE */
+
+#if defined(CONFIG_BT_NUS_RELAY)
+
+/** @brief Start connecting to the upstream bridge.
+ *
+ *  @return 0 on success, negative error code otherwise.
+ */
+int relay_init(void);
+
+/** @brief Forward data written by the downstream bridge.
+ *
+ *  @param data Received data.
+ *  @param len  Data length.
+ */
+void relay_downstream_received(const uint8_t *data, uint16_t len);
+
+#else
+
+static inline int relay_init(void)
+{
+	return 0;
+}
+
+static inline void relay_downstream_received(const uint8_t *data, uint16_t len)
+{
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+}
+
+#endif /* CONFIG_BT_NUS_RELAY */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RELAY_H_ */
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <zephyr/logging/log.h>
+
+#include "bridge_stats.h"
+#include "relay.h"
+
+LOG_MODULE_DECLARE(peripheral_uart);
+
+static atomic_t bytes;
+static atomic_t lat_sum_us;
+static atomic_t lat_cnt;
+static struct k_work_delayable report_work;
+
+static uint32_t uptime_us(void)
+{
+	return (uint32_t)k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
+void relay_trace_stamp(struct relay_trace_hdr *hdr)
+{
+	hdr->origin_us = sys_cpu_to_le32(uptime_us());
+	hdr->hops = 0;
+}
+
+void relay_trace_account(const struct relay_trace_hdr *hdr, size_t len)
+{
+	/* Only meaningful if the bridges share a time base, the offset
+	 * between their clocks is part of the latency otherwise.
+	 */
+	uint32_t lat_us = uptime_us() - sys_le32_to_cpu(hdr->origin_us);
+
+	atomic_add(&bytes, len);
+	atomic_add(&lat_sum_us, lat_us);
+	atomic_inc(&lat_cnt);
+
+	BRIDGE_STATS_SET(rt_hops, hdr->hops);
+	BRIDGE_STATS_SET(rt_lat_max_us, MAX(bridge_stats.rt_lat_max_us, lat_us));
+}
+
+static void report_work_handler(struct k_work *work)
+{
+	uint32_t bps = (uint64_t)atomic_clear(&bytes) * 8 * MSEC_PER_SEC /
+		       CONFIG_BT_NUS_RELAY_TRACE_REPORT_INTERVAL;
+	uint32_t lat_sum = atomic_clear(&lat_sum_us);
+	uint32_t lat_n = atomic_clear(&lat_cnt);
+	uint32_t lat_avg_us = lat_n ? (lat_sum / lat_n) : 0;
+
+	BRIDGE_STATS_SET(rt_bps, bps);
+	BRIDGE_STATS_SET(rt_lat_us, lat_avg_us);
+
+	if (lat_n) {
+		LOG_INF("Trace: %u hops, end-to-end %u bps, latency %u us (max %u us)",
+			bridge_stats.rt_hops, bps, lat_avg_us, bridge_stats.rt_lat_max_us);
+	}
+
+	k_work_reschedule(&report_work, K_MSEC(CONFIG_BT_NUS_RELAY_TRACE_REPORT_INTERVAL));
+}
+
+static int relay_trace_init(void)
+{
+	k_work_init_delayable(&report_work, report_work_handler);
+	k_work_reschedule(&report_work, K_MSEC(CONFIG_BT_NUS_RELAY_TRACE_REPORT_INTERVAL));
+
+	return 0;
+}
+
+SYS_INIT(relay_trace_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,603 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <zephyr/sys/util.h>
+
+#include <bluetooth/services/nus.h>
+
+#include <zephyr/logging/log.h>
+
+#include "bridge.h"
+#include "bridge_stats.h"
+#include "reliable.h"
+
+LOG_MODULE_DECLARE(peripheral_uart);
+
+#define WINDOW CONFIG_BT_NUS_RELIABLE_WINDOW
+/* An acknowledgement arrives at the earliest one connection event after
+ * the notification left, twice the notifications the host queues keeps
+ * the link busy meanwhile.
+ */
+#define IN_FLIGHT MIN(WINDOW, 2 * CONFIG_BT_CONN_TX_MAX)
+#define RTO_MAX_MS 4000
+
+/* Slots are indexed by sequence number, which must wrap along with them. */
+BUILD_ASSERT(IS_POWER_OF_TWO(WINDOW), "The send window must be a power of two");
+
+struct segment {
+	/* Uptime at which the segment was last sent. */
+	uint32_t sent_ms;
+	uint16_t len;
+	bool acked;
+	bool retransmitted;
+	struct {
+		struct reliable_data_hdr hdr;
+		uint8_t data[CONFIG_BT_NUS_RELIABLE_SEGMENT_SIZE];
+	} __packed pdu;
+};
+
+static struct segment window[WINDOW];
+/* Oldest segment not acknowledged cumulatively. */
+static uint16_t base;
+static uint16_t next_seq;
+static uint32_t next_offset;
+
+/* Data not segmented yet, retained across disconnections. */
+RING_BUF_DECLARE(backlog, CONFIG_BT_NUS_RELIABLE_BACKLOG_SIZE);
+static uint32_t backlog_in;
+static uint32_t backlog_out;
+
+/* Data dropped with a full backlog, while disconnected or in unreliable
+ * mode. The stream offset skips it once the backlog is segmented up to
+ * the point of the drop, so that the central sees where data is missing.
+ */
+static uint32_t gap;
+static uint32_t gap_pos;
+static bool gap_pending;
+
+static K_MUTEX_DEFINE(lock);
+/* Signaled when the sender thread may have something to segment. */
+static K_CONDVAR_DEFINE(sender_cv);
+/* Signaled when the backlog may have room. */
+static K_CONDVAR_DEFINE(space_cv);
+
+/* Connection of the central, the segment size follows its MTU. */
+static struct bt_conn *current_conn;
+/* Central the stream is sent to. */
+static bt_addr_le_t peer;
+static int64_t connected_at;
+
+static struct k_work_delayable retx_work;
+static struct k_work_delayable report_work;
+
+static uint32_t srtt_ms;
+static uint32_t rto_ms = CONFIG_BT_NUS_RELIABLE_RTO_MIN;
+/* Segments before this one were skipped by a selective acknowledgement. */
+static uint16_t sack_end;
+static bool fast_retx;
+/* Waiting for the first acknowledgement of the connection. */
+static bool resync;
+static bool resend_all;
+/* The central did not acknowledge in time, the data is sent without
+ * header and without retransmissions until the next connection.
+ */
+static bool unreliable;
+
+static uint32_t acked_bytes;
+static uint32_t sent_segs;
+static uint32_t retx_segs;
+
+static struct segment *segment_get(uint16_t seq)
+{
+	return &window[seq % WINDOW];
+}
+
+static bool in_window(uint16_t seq)
+{
+	return (uint16_t)(seq - base) < (uint16_t)(next_seq - base);
+}
+
+static size_t segment_size(void)
+{
+	size_t size = MIN(CONFIG_BT_NUS_RELIABLE_SEGMENT_SIZE,
+			  bt_nus_get_mtu(current_conn) - sizeof(struct reliable_data_hdr));
+
+	/* Do not segment past lost data. */
+	if (gap_pending) {
+		size = MIN(size, gap_pos - backlog_out);
+	}
+
+	return size;
+}
+
+static int segment_send(struct segment *seg)
+{
+	seg->sent_ms = k_uptime_get_32();
+
+	return bt_nus_send(NULL, (const uint8_t *)&seg->pdu, sizeof(seg->pdu.hdr) + seg->len);
+}
+
+/* Karn's algorithm, the round trip time of retransmitted segments is
+ * ambiguous and not sampled.
+ */
+static void segment_acked(struct segment *seg, uint32_t now)
+{
+	if (seg->acked) {
+		return;
+	}
+
+	seg->acked = true;
+	acked_bytes += seg->len;
+
+	if (!seg->retransmitted) {
+		uint32_t rtt_ms = now - seg->sent_ms;
+
+		srtt_ms = srtt_ms ? ((7 * srtt_ms + rtt_ms) / 8) : rtt_ms;
+		rto_ms = CLAMP(2 * srtt_ms, CONFIG_BT_NUS_RELIABLE_RTO_MIN, RTO_MAX_MS);
+	}
+}
+
+static void retx_work_handler(struct k_work *work)
+{
+	uint32_t now = k_uptime_get_32();
+	bool timeout = false;
+	bool pending = false;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	for (uint16_t seq = base; seq != next_seq; seq++) {
+		struct segment *seg = segment_get(seq);
+		bool hole = resend_all ||
+			    (fast_retx && !seg->retransmitted &&
+			     ((uint16_t)(seq - base) < (uint16_t)(sack_end - base)));
+
+		if (seg->acked) {
+			continue;
+		}
+
+		pending = true;
+
+		if (!hole && ((now - seg->sent_ms) < rto_ms)) {
+			continue;
+		}
+
+		timeout |= !hole;
+		seg->retransmitted = true;
+
+		if (segment_send(seg)) {
+			/* Out of buffers or not subscribed, try again later. */
+			break;
+		}
+
+		retx_segs++;
+		BRIDGE_STATS_INC(rel_retx);
+	}
+
+	fast_retx = false;
+	resend_all = false;
+
+	if (timeout) {
+		rto_ms = MIN(2 * rto_ms, RTO_MAX_MS);
+	}
+
+	if (pending) {
+		k_work_reschedule(&retx_work, K_MSEC(rto_ms));
+	}
+
+	k_mutex_unlock(&lock);
+}
+
+/* The central did not acknowledge anything for the whole timeout, it
+ * does not implement the stream or stalled. Its segments are dropped and
+ * the backlog is sent in plain notifications, not to block the UART.
+ */
+static void unreliable_start(void)
+{
+	uint32_t lost = 0;
+
+	for (uint16_t seq = base; seq != next_seq; seq++) {
+		if (!segment_get(seq)->acked) {
+			lost += segment_get(seq)->len;
+		}
+	}
+
+	LOG_WRN("No acknowledgement for %d ms, falling back to unreliable mode (%u bytes lost)",
+		CONFIG_BT_NUS_RELIABLE_ACK_TIMEOUT, lost);
+	BRIDGE_STATS_INCN(rel_lost_bytes, lost);
+	BRIDGE_STATS_INC(rel_fallback);
+
+	/* The stream offset still counts the bytes sent without header. */
+	base = next_seq;
+	sack_end = next_seq;
+	fast_retx = false;
+	resend_all = false;
+	resync = false;
+	unreliable = true;
+
+	k_work_cancel_delayable(&retx_work);
+	k_condvar_signal(&sender_cv);
+}
+
+void reliable_send(const uint8_t *data, size_t len)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+
+	while (len > 0) {
+		if (!gap_pending) {
+			uint32_t put = ring_buf_put(&backlog, data, len);
+
+			if (put > 0) {
+				backlog_in += put;
+				data += put;
+				len -= put;
+				k_condvar_signal(&sender_cv);
+				continue;
+			}
+		}
+
+		if (current_conn && !unreliable) {
+			/* Room is only made when the central acknowledges. */
+			if (k_condvar_wait(&space_cv, &lock,
+					   K_MSEC(CONFIG_BT_NUS_RELIABLE_ACK_TIMEOUT)) == -EAGAIN) {
+				unreliable_start();
+			}
+
+			continue;
+		}
+
+		/* Out of budget while disconnected or in unreliable mode, the
+		 * UART data is lost.
+		 */
+		if (!gap_pending) {
+			gap_pending = true;
+			gap_pos = backlog_in;
+		}
+
+		gap += len;
+		BRIDGE_STATS_INCN(rel_lost_bytes, len);
+		break;
+	}
+
+	k_mutex_unlock(&lock);
+}
+
+static bool sender_ready(void)
+{
+	if (!current_conn || resync) {
+		return false;
+	}
+
+	if (gap_pending && (backlog_out == gap_pos)) {
+		return true;
+	}
+
+	if (unreliable) {
+		return backlog_out != backlog_in;
+	}
+
+	return ((uint16_t)(next_seq - base) < IN_FLIGHT) && (backlog_out != backlog_in);
+}
+
+/* Send the backlog in plain notifications, as without the stream. */
+static void unreliable_send(void)
+{
+	/* The window is empty in unreliable mode, its slots are free. */
+	uint8_t *data = window[0].pdu.data;
+	uint32_t size = MIN(CONFIG_BT_NUS_RELIABLE_SEGMENT_SIZE, bt_nus_get_mtu(current_conn));
+	uint32_t len;
+	int err;
+
+	if (gap_pending) {
+		size = MIN(size, gap_pos - backlog_out);
+	}
+
+	len = ring_buf_get(&backlog, data, size);
+	backlog_out += len;
+	next_offset += len;
+
+	k_condvar_broadcast(&space_cv);
+	k_mutex_unlock(&lock);
+
+	err = bt_nus_send(NULL, data, len);
+	if (err) {
+		LOG_WRN("Failed to send data over BLE connection");
+		BRIDGE_STATS_INCN(rel_lost_bytes, len);
+	}
+}
+
+static void reliable_thread(void)
+{
+	for (;;) {
+		struct segment *seg;
+		uint32_t seg_len;
+
+		k_mutex_lock(&lock, K_FOREVER);
+
+		while (!sender_ready()) {
+			k_condvar_wait(&sender_cv, &lock, K_FOREVER);
+		}
+
+		if (gap_pending && (backlog_out == gap_pos)) {
+			LOG_WRN("%u bytes lost", gap);
+			next_offset += gap;
+			gap = 0;
+			gap_pending = false;
+			k_condvar_broadcast(&space_cv);
+			k_mutex_unlock(&lock);
+			continue;
+		}
+
+		if (unreliable) {
+			unreliable_send();
+			continue;
+		}
+
+		seg = segment_get(next_seq);
+		seg_len = ring_buf_get(&backlog, seg->pdu.data, segment_size());
+		backlog_out += seg_len;
+
+		seg->pdu.hdr.seq = sys_cpu_to_le16(next_seq);
+		seg->pdu.hdr.offset = sys_cpu_to_le32(next_offset);
+		seg->len = seg_len;
+		seg->acked = false;
+		seg->retransmitted = false;
+
+		next_seq++;
+		next_offset += seg_len;
+		sent_segs++;
+
+		k_condvar_broadcast(&space_cv);
+
+		/* The slot is only reused once acknowledged, the segment can
+		 * be sent without holding the lock.
+		 */
+		k_mutex_unlock(&lock);
+
+		if (segment_send(seg)) {
+			LOG_DBG("Segment %u not sent, retransmitting later",
+				sys_le16_to_cpu(seg->pdu.hdr.seq));
+		}
+
+		k_work_schedule(&retx_work, K_MSEC(rto_ms));
+	}
+}
+
+K_THREAD_DEFINE(reliable_thread_id, CONFIG_BT_NUS_THREAD_STACK_SIZE, reliable_thread, NULL, NULL,
+		NULL, 7, 0, 0);
+
+/* Start a new stream, for another central or one that lost its state.
+ * Only the segments already sent belong to the previous stream, the
+ * backlog, and the data dropped after it, start the new one at offset 0.
+ */
+static void stream_reset(void)
+{
+	uint32_t lost = 0;
+
+	for (uint16_t seq = base; seq != next_seq; seq++) {
+		if (!segment_get(seq)->acked) {
+			lost += segment_get(seq)->len;
+		}
+	}
+
+	if (lost > 0) {
+		LOG_WRN("Dropping %u bytes sent to the previous central", lost);
+		BRIDGE_STATS_INCN(rel_lost_bytes, lost);
+	}
+
+	base = 0;
+	next_seq = 0;
+	next_offset = 0;
+	sack_end = 0;
+	fast_retx = false;
+	resend_all = false;
+}
+
+static void ack_received(const struct reliable_ack *ack)
+{
+	uint16_t ack_seq = sys_le16_to_cpu(ack->seq);
+	uint32_t sack = sys_le32_to_cpu(ack->sack);
+	uint32_t now = k_uptime_get_32();
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if ((uint16_t)(ack_seq - base) > (uint16_t)(next_seq - base)) {
+		if (!resync) {
+			LOG_WRN("Acknowledgement of %u outside of the window [%u, %u)", ack_seq,
+				base, next_seq);
+			k_mutex_unlock(&lock);
+			return;
+		}
+
+		LOG_WRN("Central lost the stream state, restarting at %u", ack_seq);
+		stream_reset();
+		base = ack_seq;
+		next_seq = ack_seq;
+		sack_end = ack_seq;
+	}
+
+	if (resync) {
+		uint32_t resume_ms = k_uptime_get() - connected_at;
+
+		resync = false;
+		resend_all = true;
+		BRIDGE_STATS_SET(rel_resume_ms, resume_ms);
+
+		LOG_INF("Resuming at offset %u, %u ms after connection",
+			(ack_seq == next_seq) ? next_offset :
+						sys_le32_to_cpu(segment_get(ack_seq)->pdu.hdr.offset),
+			resume_ms);
+	}
+
+	while (base != ack_seq) {
+		segment_acked(segment_get(base), now);
+		base++;
+	}
+
+	k_condvar_signal(&sender_cv);
+
+	if ((uint16_t)(sack_end - base) > (uint16_t)(next_seq - base)) {
+		sack_end = base;
+	}
+
+	for (uint16_t seq = ack_seq + 1; sack != 0; seq++, sack >>= 1) {
+		if (!in_window(seq)) {
+			break;
+		}
+
+		if (sack & BIT(0)) {
+			segment_acked(segment_get(seq), now);
+
+			/* Segments skipped before this one were likely lost. */
+			if ((uint16_t)(seq + 1 - base) > (uint16_t)(sack_end - base)) {
+				sack_end = seq + 1;
+			}
+
+			fast_retx = true;
+		}
+	}
+
+	BRIDGE_STATS_SET(rel_srtt_ms, srtt_ms);
+
+	if (fast_retx || resend_all) {
+		k_work_reschedule(&retx_work, K_NO_WAIT);
+	}
+
+	k_mutex_unlock(&lock);
+}
+
+void reliable_received(const uint8_t *data, uint16_t len)
+{
+	bool plain;
+
+	/* A central that does not implement the stream writes plain data,
+	 * which has no type byte.
+	 */
+	k_mutex_lock(&lock, K_FOREVER);
+	plain = unreliable;
+	k_mutex_unlock(&lock);
+
+	if (plain) {
+		bridge_uart_write(data, len);
+		return;
+	}
+
+	if (len < 1) {
+		return;
+	}
+
+	switch (data[0]) {
+	case RELIABLE_TYPE_DATA:
+		bridge_uart_write(&data[1], len - 1);
+		break;
+	case RELIABLE_TYPE_ACK:
+		if (len < sizeof(struct reliable_ack)) {
+			LOG_WRN("Truncated acknowledgement");
+			break;
+		}
+
+		ack_received((const struct reliable_ack *)data);
+		break;
+	default:
+		LOG_WRN("Unknown write type 0x%02x", data[0]);
+		break;
+	}
+}
+
+static void report_work_handler(struct k_work *work)
+{
+	uint32_t goodput_bps;
+	uint32_t retx_pct;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	goodput_bps = (uint64_t)acked_bytes * 8 * MSEC_PER_SEC /
+		      CONFIG_BT_NUS_RELIABLE_REPORT_INTERVAL;
+	retx_pct = sent_segs ? (retx_segs * 100 / sent_segs) : 0;
+	acked_bytes = 0;
+	sent_segs = 0;
+	retx_segs = 0;
+
+	k_mutex_unlock(&lock);
+
+	BRIDGE_STATS_SET(rel_goodput_bps, goodput_bps);
+	BRIDGE_STATS_SET(rel_retx_pct, retx_pct);
+
+	LOG_INF("Reliable stream: goodput %u bps, %u%% retransmitted, RTT %u ms", goodput_bps,
+		retx_pct, srtt_ms);
+
+	k_work_reschedule(&report_work, K_MSEC(CONFIG_BT_NUS_RELIABLE_REPORT_INTERVAL));
+}
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	const bt_addr_le_t *dst = bt_conn_get_dst(conn);
+
+	if (err) {
+		return;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (!current_conn) {
+		current_conn = bt_conn_ref(conn);
+	}
+
+	/* Only the identity address of a bonded central, or a central
+	 * using its public address, is known again after reconnecting.
+	 */
+	if (!bt_addr_le_eq(&peer, dst)) {
+		if (!bt_addr_le_eq(&peer, BT_ADDR_LE_ANY)) {
+			stream_reset();
+		}
+
+		bt_addr_le_copy(&peer, dst);
+	}
+
+	/* Wait for the first acknowledgement of the central, written once
+	 * it subscribed, to send everything it has not received.
+	 */
+	resync = true;
+	unreliable = false;
+	connected_at = k_uptime_get();
+	rto_ms = CONFIG_BT_NUS_RELIABLE_RTO_MIN;
+
+	k_condvar_broadcast(&space_cv);
+	k_mutex_unlock(&lock);
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (conn == current_conn) {
+		bt_conn_unref(current_conn);
+		current_conn = NULL;
+	}
+
+	/* Writers waiting for room now retain or drop their data. */
+	k_condvar_broadcast(&space_cv);
+	k_mutex_unlock(&lock);
+}
+
+BT_CONN_CB_DEFINE(reliable_conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+};
+
+int reliable_init(void)
+{
+	k_work_init_delayable(&retx_work, retx_work_handler);
+	k_work_init_delayable(&report_work, report_work_handler);
+	k_work_reschedule(&report_work, K_MSEC(CONFIG_BT_NUS_RELIABLE_REPORT_INTERVAL));
+
+	return 0;
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef RELIABLE_H_
+#define RELIABLE_H_
+
+/** @file
+ *  @brief Reliable stream over NUS
+ *
+ *  Numbers the notifications carrying the data received from the UART,
+ *  keeps them until the central acknowledges them and sends them again if
+ *  they are not acknowledged in time. The stream resumes where it stopped
+ *  when the same central reconnects.
+ */
+
+#include <stddef.h>
+#include <zephyr/types.h>
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Type of a write from the central, first byte of the write. */
+enum reliable_type {
+	/** Data to send to the UART follows. */
+	RELIABLE_TYPE_DATA = 0x01,
+	/** Acknowledgement, struct reliable_ack. */
+	RELIABLE_TYPE_ACK = 0x02,
+};
+
+/** Header of each notification, little-endian. */
+struct reliable_data_hdr {
+	/** Segment sequence number. */
+	uint16_t seq;
+	/** Offset of the first data byte in the stream. */
+	uint32_t offset;
+} __packed;
+
+/** Acknowledgement written by the central, little-endian. */
+struct reliable_ack {
+	/** RELIABLE_TYPE_ACK. */
+	uint8_t type;
+	/** Next expected sequence number, all segments before were received. */
+	uint16_t seq;
+	/** Bit n set if segment seq + 1 + n was received. */
+	uint32_t sack;
+} __packed;
+
+#if defined(CONFIG_BT_NUS_RELIABLE)
+
+/** @brief Start the report of the stream statistics.
+ *
+ *  @return 0 on success, negative error code otherwise.
+ */
+int reliable_init(void);
+
+/** @brief Send data over the stream.
+ *
+ *  Adds the data to the backlog segmented by the sender thread, waiting
+ *  for room while connected, up to CONFIG_BT_NUS_RELIABLE_ACK_TIMEOUT
+ *  before falling back to unreliable mode. While disconnected or in
+ *  unreliable mode, the data that does not fit in the backlog is dropped.
+ *
+ *  @param data Data to send.
+ *  @param len  Data length.
+ */
+void reliable_send(const uint8_t *data, size_t len);
+
+/** @brief Handle a write from the central.
+ *
+ *  In unreliable mode, the written data goes to the UART as is.
+ *
+ *  @param data Written data, starting with an enum reliable_type unless in
+ *              unreliable mode.
+ *  @param len  Data length.
+ */
+void reliable_received(const uint8_t *data, uint16_t len);
+
+#else
+
+static inline int reliable_init(void)
+{
+	return 0;
+}
+
+static inline void reliable_send(const uint8_t *data, size_t len)
+{
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+}
+
+static inline void reliable_received(const uint8_t *data, uint16_t len)
+{
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+}
+
+#endif /* CONFIG_BT_NUS_RELIABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RELIABLE_H_ */
@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/version.h>
+
+#if defined(CONFIG_MCUMGR_GRP_OS_RESET_HOOK)
+#include <zephyr/mgmt/mcumgr/mgmt/callbacks.h>
+#endif
+
+#include <zephyr/logging/log.h>
+
+#include "bridge_stats.h"
+#include "settings_sched.h"
+
+LOG_MODULE_DECLARE(peripheral_uart);
+
+/* Longer gaps between notifications are idle periods, not stalls. */
+#define STALL_MAX_US USEC_PER_SEC
+
+/* Destination of settings_save_one(), private to the settings subsystem
+ * and only accessed with the settings lock held, as the subsystem does.
+ * The subsystem has no public API to get or replace it. The declaration
+ * and its use in subsys/settings/src/settings_store.c were checked
+ * against Zephyr 4.1, the version of this nRF Connect SDK release, and
+ * must be checked again before moving to another one.
+ */
+BUILD_ASSERT((KERNEL_VERSION_MAJOR == 4) && (KERNEL_VERSION_MINOR == 1),
+	     "settings_save_dst is private, check its use for this Zephyr version");
+extern struct settings_store *settings_save_dst;
+
+struct pending_write {
+	char name[SETTINGS_MAX_NAME_LEN + 1];
+	uint8_t value[CONFIG_BT_NUS_SETTINGS_SCHED_VALUE_SIZE];
+	size_t len;
+	bool used;
+};
+
+/* Settings rebuilt by the peers if lost, their writes can be held back.
+ * The CCC of a bonded peer is not, it does not subscribe again after a
+ * reset. CONFIG_BT_SETTINGS_CCC_STORE_ON_WRITE=n already moves the CCC
+ * writes out of the data flow, to the disconnection.
+ */
+static const char *const deferrable[] = {
+	"bt/cf/",
+	"bt/hash",
+	"bt/sc/",
+};
+
+static struct settings_store *backend;
+static struct pending_write pending[CONFIG_BT_NUS_SETTINGS_SCHED_SLOTS];
+static K_MUTEX_DEFINE(lock);
+static struct k_work_delayable flush_work;
+
+/* Uptime of the last data on the link and of the oldest held back write. */
+static atomic_t last_activity;
+static int64_t deferred_at;
+
+/* Writes to flash started, and the count seen by the last notification. */
+static atomic_t writes;
+static atomic_val_t sent_writes;
+static uint32_t sent_cycles;
+
+static bool is_deferrable(const char *name)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(deferrable); i++) {
+		if (strncmp(name, deferrable[i], strlen(deferrable[i])) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static uint32_t idle_ms(void)
+{
+	return k_uptime_get_32() - (uint32_t)atomic_get(&last_activity);
+}
+
+static int backend_save(const char *name, const char *value, size_t len)
+{
+	uint32_t start;
+	uint32_t write_us;
+	int err;
+
+	atomic_inc(&writes);
+	start = k_cycle_get_32();
+
+	err = backend->cs_itf->csi_save(backend, name, value, len);
+
+	write_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+	BRIDGE_STATS_INC(set_written);
+	BRIDGE_STATS_SET(set_write_us, write_us);
+	BRIDGE_STATS_SET(set_write_max_us, MAX(bridge_stats.set_write_max_us, write_us));
+
+	return err;
+}
+
+/* Called with the settings lock and the lock held, in this order. */
+static void pending_flush(void)
+{
+	int err;
+
+	for (size_t i = 0; i < ARRAY_SIZE(pending); i++) {
+		struct pending_write *write = &pending[i];
+
+		if (!write->used) {
+			continue;
+		}
+
+		err = backend_save(write->name, write->len ? (const char *)write->value : NULL,
+				   write->len);
+		if (err) {
+			LOG_WRN("Cannot write setting %s (err %d)", write->name, err);
+		}
+
+		write->used = false;
+	}
+
+	BRIDGE_STATS_SET(set_pending, 0);
+}
+
+static bool pending_add(const char *name, const char *value, size_t len)
+{
+	struct pending_write *free_slot = NULL;
+	struct pending_write *write = NULL;
+	size_t used = 0;
+
+	if ((len > sizeof(pending[0].value)) || (strlen(name) >= sizeof(pending[0].name))) {
+		return false;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(pending); i++) {
+		if (!pending[i].used) {
+			free_slot = free_slot ? free_slot : &pending[i];
+			continue;
+		}
+
+		used++;
+
+		if (strcmp(pending[i].name, name) == 0) {
+			write = &pending[i];
+		}
+	}
+
+	if (write) {
+		/* Only the last value of a setting is written. */
+		BRIDGE_STATS_INC(set_coalesced);
+	} else if (free_slot) {
+		write = free_slot;
+		strcpy(write->name, name);
+		write->used = true;
+		used++;
+	} else {
+		return false;
+	}
+
+	if (len) {
+		memcpy(write->value, value, len);
+	}
+
+	write->len = len;
+
+	if (used == 1) {
+		deferred_at = k_uptime_get();
+	}
+
+	BRIDGE_STATS_INC(set_deferred);
+	BRIDGE_STATS_SET(set_pending, used);
+
+	return true;
+}
+
+static int sched_save(struct settings_store *cs, const char *name, const char *value,
+		      size_t val_len)
+{
+	int err = 0;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (is_deferrable(name) && (idle_ms() < CONFIG_BT_NUS_SETTINGS_SCHED_IDLE_TIME) &&
+	    pending_add(name, value, val_len)) {
+		k_work_schedule(&flush_work, K_MSEC(CONFIG_BT_NUS_SETTINGS_SCHED_IDLE_TIME));
+		goto out;
+	}
+
+	/* A held back value of the setting must not overwrite this one. */
+	for (size_t i = 0; i < ARRAY_SIZE(pending); i++) {
+		if (pending[i].used && (strcmp(pending[i].name, name) == 0)) {
+			pending[i].used = false;
+		}
+	}
+
+	err = backend_save(name, value, val_len);
+
+out:
+	k_mutex_unlock(&lock);
+
+	return err;
+}
+
+static int sched_save_start(struct settings_store *cs)
+{
+	return backend->cs_itf->csi_save_start ? backend->cs_itf->csi_save_start(backend) : 0;
+}
+
+static int sched_save_end(struct settings_store *cs)
+{
+	return backend->cs_itf->csi_save_end ? backend->cs_itf->csi_save_end(backend) : 0;
+}
+
+static void *sched_storage_get(struct settings_store *cs)
+{
+	return backend->cs_itf->csi_storage_get ? backend->cs_itf->csi_storage_get(backend) :
+						  NULL;
+}
+
+static const struct settings_store_itf sched_itf = {
+	.csi_save_start = sched_save_start,
+	.csi_save = sched_save,
+	.csi_save_end = sched_save_end,
+	.csi_storage_get = sched_storage_get,
+};
+
+static struct settings_store sched_store = {
+	.cs_itf = &sched_itf,
+};
+
+static void flush_work_handler(struct k_work *work)
+{
+	uint32_t idle = idle_ms();
+	uint32_t held;
+
+	settings_lock_take();
+	k_mutex_lock(&lock, K_FOREVER);
+
+	held = k_uptime_get() - deferred_at;
+
+	if ((idle < CONFIG_BT_NUS_SETTINGS_SCHED_IDLE_TIME) &&
+	    (held < CONFIG_BT_NUS_SETTINGS_SCHED_MAX_DELAY)) {
+		k_work_reschedule(&flush_work,
+				  K_MSEC(MIN(CONFIG_BT_NUS_SETTINGS_SCHED_IDLE_TIME - idle,
+					     CONFIG_BT_NUS_SETTINGS_SCHED_MAX_DELAY - held)));
+	} else {
+		pending_flush();
+	}
+
+	k_mutex_unlock(&lock);
+	settings_lock_release();
+}
+
+void settings_sched_activity(void)
+{
+	atomic_set(&last_activity, k_uptime_get_32());
+}
+
+void settings_sched_sent(void)
+{
+	uint32_t now = k_cycle_get_32();
+	atomic_val_t count = atomic_get(&writes);
+	uint32_t gap_us;
+
+	settings_sched_activity();
+
+	/* The time since the previous notification completed includes a
+	 * write to flash.
+	 */
+	gap_us = k_cyc_to_us_floor32(now - sent_cycles);
+
+	if ((count != sent_writes) && sent_cycles && (gap_us < STALL_MAX_US)) {
+		BRIDGE_STATS_SET(set_stall_us, gap_us);
+		BRIDGE_STATS_SET(set_stall_max_us, MAX(bridge_stats.set_stall_max_us, gap_us));
+	}
+
+	sent_writes = count;
+	sent_cycles = now;
+}
+
+void settings_sched_flush(void)
+{
+	if (!backend) {
+		return;
+	}
+
+	k_work_cancel_delayable(&flush_work);
+
+	settings_lock_take();
+	k_mutex_lock(&lock, K_FOREVER);
+	pending_flush();
+	k_mutex_unlock(&lock);
+	settings_lock_release();
+}
+
+#if defined(CONFIG_MCUMGR_GRP_OS_RESET_HOOK)
+static enum mgmt_cb_return os_mgmt_event(uint32_t event, enum mgmt_cb_return prev_status,
+					 int32_t *rc, uint16_t *group, bool *abort_more,
+					 void *data, size_t data_size)
+{
+	settings_sched_flush();
+
+	return MGMT_CB_OK;
+}
+
+static struct mgmt_callback os_mgmt_cb = {
+	.callback = os_mgmt_event,
+	.event_id = MGMT_EVT_OP_OS_MGMT_RESET,
+};
+#endif
+
+int settings_sched_init(void)
+{
+	settings_lock_take();
+
+	if (!settings_save_dst) {
+		settings_lock_release();
+		return -ENODEV;
+	}
+
+	backend = settings_save_dst;
+
+	k_work_init_delayable(&flush_work, flush_work_handler);
+	settings_dst_register(&sched_store);
+
+	settings_lock_release();
+
+#if defined(CONFIG_MCUMGR_GRP_OS_RESET_HOOK)
+	mgmt_callback_register(&os_mgmt_cb);
+#endif
+
+	return 0;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SETTINGS_SCHED_H_
+#define SETTINGS_SCHED_H_
+
+/** @file
+ *  @brief Settings write scheduler
+ *
+ *  Sits in front of the settings storage backend. While data flows, writes
+ *  of the settings that can be rebuilt, such as the CCC and client
+ *  features of the bonded peers, are held back in RAM and later writes of
+ *  the same setting replace them. They are written once the link is idle,
+ *  or before a reset. Bonding keys and the other settings are written at
+ *  once.
+ */
+
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CONFIG_BT_NUS_SETTINGS_SCHED)
+
+/** @brief Put the scheduler in front of the settings storage backend.
+ *
+ *  Must be called after the settings subsystem is initialized.
+ *
+ *  @return 0 on success, negative error code otherwise.
+ */
+int settings_sched_init(void);
+
+/** @brief Account data moving over the link.
+ *
+ *  Can be called from interrupt context.
+ */
+void settings_sched_activity(void);
+
+/** @brief Account a notification sent, measuring the time the
+ *  notifications were stalled by a write to flash.
+ */
+void settings_sched_sent(void);
+
+/** @brief Write the settings held back, for instance before a reset. */
+void settings_sched_flush(void);
+
+#else
+
+static inline int settings_sched_init(void)
+{
+	return 0;
+}
+
+static inline void settings_sched_activity(void) {}
+
+static inline void settings_sched_sent(void) {}
+
+static inline void settings_sched_flush(void) {}
+
+#endif /* CONFIG_BT_NUS_SETTINGS_SCHED */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SETTINGS_SCHED_H_ */
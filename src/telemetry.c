@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+
+#include <zephyr/logging/log.h>
+
+#include "bridge_stats.h"
+#include "event_ring.h"
+#include "telemetry.h"
+
+LOG_MODULE_DECLARE(peripheral_uart);
+
+#ifdef CONFIG_BT_NUS_AUTHEN
+#define TELEMETRY_PERM_READ  BT_GATT_PERM_READ_AUTHEN
+#define TELEMETRY_PERM_WRITE BT_GATT_PERM_WRITE_AUTHEN
+#else
+#define TELEMETRY_PERM_READ  BT_GATT_PERM_READ
+#define TELEMETRY_PERM_WRITE BT_GATT_PERM_WRITE
+#endif
+
+static struct k_work_delayable notify_work;
+static uint16_t notify_interval = CONFIG_BT_NUS_TELEMETRY_INTERVAL;
+static bool notify_enabled;
+
+static void link_info_get(struct bt_conn *conn, struct telemetry_snapshot *snap)
+{
+	struct bt_conn_info info;
+
+	if (!conn || bt_conn_get_info(conn, &info) || (info.state != BT_CONN_STATE_CONNECTED)) {
+		return;
+	}
+
+	snap->mtu = sys_cpu_to_le16(bt_gatt_get_mtu(conn));
+	snap->conn_interval = sys_cpu_to_le16(info.le.interval);
+	snap->conn_latency = sys_cpu_to_le16(info.le.latency);
+#if defined(CONFIG_BT_USER_PHY_UPDATE)
+	snap->phy = info.le.phy->tx_phy;
+#else
+	snap->phy = BT_GAP_LE_PHY_1M;
+#endif
+}
+
+static void snapshot_get(struct bt_conn *conn, struct telemetry_snapshot *snap)
+{
+	memset(snap, 0, sizeof(*snap));
+
+	snap->version = TELEMETRY_SNAPSHOT_VERSION;
+	snap->uptime_ms = sys_cpu_to_le32(k_uptime_get_32());
+
+	snap->uart_rx_bytes = sys_cpu_to_le32(bridge_stats.uart_rx_bytes);
+	snap->ble_tx_bytes = sys_cpu_to_le32(bridge_stats.ble_tx_bytes);
+	snap->ble_rx_bytes = sys_cpu_to_le32(bridge_stats.ble_rx_bytes);
+	snap->uart_tx_bytes = sys_cpu_to_le32(bridge_stats.uart_tx_bytes);
+
+	snap->ble_tx_fail = sys_cpu_to_le32(bridge_stats.ble_tx_fail);
+	snap->ble_rx_drop = sys_cpu_to_le32(bridge_stats.ble_rx_drop);
+	snap->uart_rx_buf_fail = sys_cpu_to_le32(bridge_stats.uart_rx_buf_fail);
+
+	snap->rx_q_peak = sys_cpu_to_le16(MIN(bridge_stats.rx_q_peak, UINT16_MAX));
+	snap->tx_q_peak = sys_cpu_to_le16(MIN(bridge_stats.tx_q_peak, UINT16_MAX));
+	snap->buf_in_use = sys_cpu_to_le16(MIN(bridge_stats.buf_in_use, UINT16_MAX));
+	snap->buf_peak = sys_cpu_to_le16(MIN(bridge_stats.buf_peak, UINT16_MAX));
+
+	snap->lat_p50_us = sys_cpu_to_le32(bridge_stats_latency_percentile(50));
+	snap->lat_p90_us = sys_cpu_to_le32(bridge_stats_latency_percentile(90));
+	snap->lat_p99_us = sys_cpu_to_le32(bridge_stats_latency_percentile(99));
+	snap->lat_max_us = sys_cpu_to_le32(bridge_stats.lat_max_us);
+
+	link_info_get(conn, snap);
+}
+
+static void conn_first_get(struct bt_conn *conn, void *data)
+{
+	struct bt_conn **first = data;
+
+	if (!*first) {
+		*first = bt_conn_ref(conn);
+	}
+}
+
+static ssize_t snapshot_read(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+			     void *buf, uint16_t len, uint16_t offset)
+{
+	struct telemetry_snapshot snap;
+
+	snapshot_get(conn, &snap);
+
+	return bt_gatt_attr_read(conn, attr, buf, len, offset, &snap, sizeof(snap));
+}
+
+static ssize_t interval_write(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+			      const void *buf, uint16_t len, uint16_t offset, uint8_t flags)
+{
+	if (offset) {
+		return BT_GATT_ERR(BT_ATT_ERR_INVALID_OFFSET);
+	}
+
+	if (len != sizeof(notify_interval)) {
+		return BT_GATT_ERR(BT_ATT_ERR_INVALID_ATTRIBUTE_LEN);
+	}
+
+	notify_interval = sys_get_le16(buf);
+	LOG_INF("Telemetry notification interval set to %u ms", notify_interval);
+
+	if (notify_enabled) {
+		/* An interval of 0 requests a single notification. */
+		k_work_reschedule(&notify_work, K_MSEC(notify_interval));
+	}
+
+	return len;
+}
+
+#if defined(CONFIG_BT_NUS_EVENT_RING)
+static ssize_t events_read(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+			   void *buf, uint16_t len, uint16_t offset)
+{
+	return event_ring_read(buf, len, offset);
+}
+#endif
+
+static void snapshot_ccc_changed(const struct bt_gatt_attr *attr, uint16_t value)
+{
+	notify_enabled = (value == BT_GATT_CCC_NOTIFY);
+
+	if (notify_enabled && notify_interval) {
+		k_work_reschedule(&notify_work, K_NO_WAIT);
+	} else {
+		k_work_cancel_delayable(&notify_work);
+	}
+}
+
+BT_GATT_SERVICE_DEFINE(telemetry_svc,
+BT_GATT_PRIMARY_SERVICE(BT_UUID_TELEMETRY),
+	BT_GATT_CHARACTERISTIC(BT_UUID_TELEMETRY_SNAPSHOT,
+			       BT_GATT_CHRC_READ | BT_GATT_CHRC_NOTIFY | BT_GATT_CHRC_WRITE,
+			       TELEMETRY_PERM_READ | TELEMETRY_PERM_WRITE,
+			       snapshot_read, interval_write, NULL),
+	BT_GATT_CCC(snapshot_ccc_changed, TELEMETRY_PERM_READ | TELEMETRY_PERM_WRITE),
+#if defined(CONFIG_BT_NUS_EVENT_RING)
+	BT_GATT_CHARACTERISTIC(BT_UUID_TELEMETRY_EVENTS, BT_GATT_CHRC_READ,
+			       TELEMETRY_PERM_READ, events_read, NULL, NULL),
+#endif
+);
+
+static void notify_work_handler(struct k_work *work)
+{
+	struct telemetry_snapshot snap;
+	struct bt_conn *conn = NULL;
+	int err;
+
+	bt_conn_foreach(BT_CONN_TYPE_LE, conn_first_get, &conn);
+	snapshot_get(conn, &snap);
+
+	if (conn) {
+		bt_conn_unref(conn);
+	}
+
+	/* The snapshot only fits in a notification once the ATT MTU has been
+	 * increased; centrals with the default MTU have to read it instead.
+	 */
+	err = bt_gatt_notify(NULL, &telemetry_svc.attrs[1], &snap, sizeof(snap));
+	if (err) {
+		LOG_DBG("Cannot notify telemetry snapshot (err: %d)", err);
+	}
+
+	if (notify_enabled && notify_interval) {
+		k_work_reschedule(&notify_work, K_MSEC(notify_interval));
+	}
+}
+
+static int telemetry_init(void)
+{
+	k_work_init_delayable(&notify_work, notify_work_handler);
+
+	return 0;
+}
+
+SYS_INIT(telemetry_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+/** @file
+ *  @brief Bridge telemetry GATT service
+ *
+ *  Exposes a binary snapshot of the bridge performance counters through a
+ *  read/notify characteristic. Writing a little-endian 16-bit value to the
+ *  characteristic sets the notification interval in milliseconds, 0 stops
+ *  periodic notifications. When the event ring is enabled, a second
+ *  characteristic returns its content as an array of struct event_entry.
+ */
+
+#include <zephyr/types.h>
+#include <zephyr/bluetooth/uuid.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief UUID of the telemetry service. */
+#define BT_UUID_TELEMETRY_VAL \
+	BT_UUID_128_ENCODE(0x2d8a0001, 0x6b1e, 0x4c3a, 0x9a55, 0x2f61c7e0b4d1)
+
+/** @brief UUID of the snapshot characteristic. */
+#define BT_UUID_TELEMETRY_SNAPSHOT_VAL \
+	BT_UUID_128_ENCODE(0x2d8a0002, 0x6b1e, 0x4c3a, 0x9a55, 0x2f61c7e0b4d1)
+
+/** @brief UUID of the retained event ring characteristic. */
+#define BT_UUID_TELEMETRY_EVENTS_VAL \
+	BT_UUID_128_ENCODE(0x2d8a0003, 0x6b1e, 0x4c3a, 0x9a55, 0x2f61c7e0b4d1)
+
+#define BT_UUID_TELEMETRY          BT_UUID_DECLARE_128(BT_UUID_TELEMETRY_VAL)
+#define BT_UUID_TELEMETRY_SNAPSHOT BT_UUID_DECLARE_128(BT_UUID_TELEMETRY_SNAPSHOT_VAL)
+#define BT_UUID_TELEMETRY_EVENTS   BT_UUID_DECLARE_128(BT_UUID_TELEMETRY_EVENTS_VAL)
+
+/** Version of the snapshot layout, increased on incompatible changes. */
+#define TELEMETRY_SNAPSHOT_VERSION 1
+
+/** @brief Binary performance snapshot.
+ *
+ *  All multi-byte fields are little-endian. Link parameters are zero when
+ *  not connected.
+ */
+struct telemetry_snapshot {
+	uint8_t version;
+	/** Transmitter PHY, as BT_GAP_LE_PHY_* value. */
+	uint8_t phy;
+	/** ATT MTU. */
+	uint16_t mtu;
+	/** Connection interval in units of 1.25 ms. */
+	uint16_t conn_interval;
+	/** Peripheral latency in connection events. */
+	uint16_t conn_latency;
+	uint32_t uptime_ms;
+	/** Bytes received from the UART. */
+	uint32_t uart_rx_bytes;
+	/** Bytes sent over Bluetooth LE. */
+	uint32_t ble_tx_bytes;
+	/** Bytes received over Bluetooth LE. */
+	uint32_t ble_rx_bytes;
+	/** Bytes sent to the UART. */
+	uint32_t uart_tx_bytes;
+	/** Notifications that could not be sent. */
+	uint32_t ble_tx_fail;
+	/** Bytes received over Bluetooth LE that were dropped. */
+	uint32_t ble_rx_drop;
+	/** UART receive buffer allocation failures. */
+	uint32_t uart_rx_buf_fail;
+	/** High-watermark of the UART RX queue, in buffers. */
+	uint16_t rx_q_peak;
+	/** High-watermark of the UART TX queue, in buffers. */
+	uint16_t tx_q_peak;
+	/** Buffers currently allocated. */
+	uint16_t buf_in_use;
+	/** High-watermark of allocated buffers. */
+	uint16_t buf_peak;
+	/** UART RX to Bluetooth LE TX latency percentiles, in microseconds. */
+	uint32_t lat_p50_us;
+	uint32_t lat_p90_us;
+	uint32_t lat_p99_us;
+	uint32_t lat_max_us;
+} __packed;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TELEMETRY_H_ */
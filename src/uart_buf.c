@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/sys/atomic.h>
+
+#include <zephyr/logging/log.h>
+
+#include "bridge_stats.h"
+#include "event_ring.h"
+#include "uart_buf.h"
+
+LOG_MODULE_DECLARE(peripheral_uart);
+
+static const struct device *uart;
+static K_FIFO_DEFINE(fifo_uart_tx_data);
+
+/* Buffer being transmitted, length and uptime at which it was started.
+ * Updated with tx_lock held, which readers take to get them together.
+ */
+static struct {
+	struct uart_data_t *buf;
+	size_t len;
+	int64_t start;
+	/* Drop the aborted transmission instead of resuming it. */
+	bool drop;
+} tx_state;
+
+static struct k_spinlock tx_lock;
+
+/* Work item waiting for the next buffer to be freed. */
+static struct k_work_delayable *wait_work;
+static atomic_t waiting;
+
+struct uart_data_t *uart_buf_alloc_at(const char *site)
+{
+	struct uart_data_t *buf;
+
+#if defined(CONFIG_BT_NUS_FAULT_INJECTION)
+	static atomic_t alloc_count;
+
+	if (((atomic_inc(&alloc_count) + 1) % CONFIG_BT_NUS_FAULT_ALLOC_FAIL_RATE) == 0) {
+		bridge_stats_buf_alloc(false);
+		return NULL;
+	}
+#endif
+
+	buf = k_malloc(sizeof(*buf));
+
+	bridge_stats_buf_alloc(buf != NULL);
+
+	if (!buf) {
+		event_ring_log(EVENT_ALLOC_FAIL, 0, 0);
+	} else {
+		buf->len = 0;
+#if defined(CONFIG_BT_NUS_LANES)
+		buf->prio = false;
+#endif
+#if defined(CONFIG_BT_NUS_DEADLINE)
+		buf->handed = 0;
+#endif
+#if defined(CONFIG_BT_NUS_BUF_TRACKING)
+		buf_track_alloc(&buf->track, site);
+#endif
+	}
+
+	return buf;
+}
+
+void uart_buf_free(struct uart_data_t *buf)
+{
+#if defined(CONFIG_BT_NUS_BUF_TRACKING)
+	if (!buf_track_free(&buf->track)) {
+		return;
+	}
+#endif
+
+	bridge_stats_buf_free();
+	k_free(buf);
+
+	if (atomic_cas(&waiting, 1, 0)) {
+		k_work_reschedule(wait_work, K_NO_WAIT);
+	}
+}
+
+void uart_buf_wait(struct k_work_delayable *work)
+{
+	wait_work = work;
+	atomic_set(&waiting, 1);
+}
+
+static void uart_tx_state_set(struct uart_data_t *buf, size_t len)
+{
+	k_spinlock_key_t key = k_spin_lock(&tx_lock);
+
+	tx_state.buf = buf;
+	tx_state.len = len;
+	tx_state.start = k_uptime_get();
+
+	k_spin_unlock(&tx_lock, key);
+}
+
+void uart_tx_init(const struct device *dev)
+{
+	uart = dev;
+}
+
+int uart_tx_start(struct uart_data_t *buf, size_t offset)
+{
+	int err;
+
+	err = uart_tx(uart, &buf->data[offset], buf->len - offset, SYS_FOREVER_MS);
+	if (!err) {
+		uart_tx_state_set(buf, buf->len - offset);
+		UART_BUF_OWNER(buf, BUF_OWNER_UART_TX);
+	}
+
+	return err;
+}
+
+static void uart_tx_next(void)
+{
+	struct uart_data_t *buf;
+
+	buf = k_fifo_get(&fifo_uart_tx_data, K_NO_WAIT);
+	if (!buf) {
+		return;
+	}
+
+	bridge_stats_queue_get(BRIDGE_QUEUE_UART_TX);
+
+	if (uart_tx_start(buf, 0)) {
+		LOG_WRN("Failed to send data over UART");
+		/* Another transmission was started meanwhile, keep the
+		 * buffer at the head of the queue for its completion.
+		 */
+		bridge_stats_queue_put(BRIDGE_QUEUE_UART_TX);
+		UART_BUF_OWNER(buf, BUF_OWNER_TX_QUEUE);
+		k_queue_prepend(&fifo_uart_tx_data._queue, buf);
+	}
+}
+
+void uart_tx_send(struct uart_data_t *buf)
+{
+	if (uart_tx_start(buf, 0)) {
+		BRIDGE_STATS_INC(uart_tx_queued);
+		bridge_stats_queue_put(BRIDGE_QUEUE_UART_TX);
+		UART_BUF_OWNER(buf, BUF_OWNER_TX_QUEUE);
+		k_fifo_put(&fifo_uart_tx_data, buf);
+	}
+}
+
+HOT_PATH void uart_tx_event(const struct uart_event *evt)
+{
+	static size_t aborted_len;
+	static uint8_t *aborted_buf;
+	struct uart_data_t *buf;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+		if ((evt->data.tx.len == 0) ||
+		    (!evt->data.tx.buf)) {
+			return;
+		}
+
+		if (aborted_buf) {
+			buf = CONTAINER_OF(aborted_buf, struct uart_data_t,
+					   data[0]);
+			aborted_buf = NULL;
+			aborted_len = 0;
+		} else {
+			buf = CONTAINER_OF(evt->data.tx.buf, struct uart_data_t,
+					   data[0]);
+		}
+
+		uart_tx_state_set(NULL, 0);
+
+		BRIDGE_STATS_INCN(uart_tx_bytes, buf->len);
+		uart_buf_free(buf);
+
+		uart_tx_next();
+
+		break;
+
+	case UART_TX_ABORTED:
+		BRIDGE_STATS_INC(uart_tx_abort);
+		if (!aborted_buf) {
+			aborted_buf = (uint8_t *)evt->data.tx.buf;
+		}
+
+		aborted_len += evt->data.tx.len;
+		buf = CONTAINER_OF((void *)aborted_buf, struct uart_data_t,
+				   data);
+
+		if (tx_state.drop) {
+			/* Transmission aborted by uart_tx_drop(). */
+			tx_state.drop = false;
+		} else if (aborted_len >= buf->len) {
+			/* Everything was sent before the abort took effect,
+			 * no TX_DONE will follow for this buffer.
+			 */
+			BRIDGE_STATS_INCN(uart_tx_bytes, buf->len);
+		} else if (!uart_tx_start(buf, aborted_len)) {
+			break;
+		} else {
+			LOG_WRN("Cannot resume aborted UART transmission");
+		}
+
+		/* The buffer is done with, release it here since TX_DONE
+		 * would otherwise free it based on the stale aborted_buf.
+		 */
+		BRIDGE_STATS_INCN(uart_tx_drop, buf->len - MIN(aborted_len, buf->len));
+		uart_tx_state_set(NULL, 0);
+		aborted_buf = NULL;
+		aborted_len = 0;
+		uart_buf_free(buf);
+		uart_tx_next();
+
+		break;
+
+	default:
+		break;
+	}
+}
+
+bool uart_tx_busy(void)
+{
+	return uart_tx_ongoing(NULL, NULL) || !k_fifo_is_empty(&fifo_uart_tx_data);
+}
+
+bool uart_tx_ongoing(size_t *len, int64_t *start)
+{
+	k_spinlock_key_t key = k_spin_lock(&tx_lock);
+	bool busy = (tx_state.buf != NULL);
+
+	if (len) {
+		*len = tx_state.len;
+	}
+
+	if (start) {
+		*start = tx_state.start;
+	}
+
+	k_spin_unlock(&tx_lock, key);
+
+	return busy;
+}
+
+void uart_tx_drop(void)
+{
+	if (!tx_state.buf) {
+		uart_tx_next();
+		return;
+	}
+
+	tx_state.drop = true;
+
+	if (uart_tx_abort(uart)) {
+		/* Nothing is being transmitted, the state was stale. */
+		tx_state.drop = false;
+		uart_tx_state_set(NULL, 0);
+		uart_tx_next();
+	}
+}
+
+void uart_tx_queue_flush(void)
+{
+	struct uart_data_t *buf;
+
+	while ((buf = k_fifo_get(&fifo_uart_tx_data, K_NO_WAIT))) {
+		bridge_stats_queue_get(BRIDGE_QUEUE_UART_TX);
+		BRIDGE_STATS_INCN(uart_tx_drop, buf->len);
+		uart_buf_free(buf);
+	}
+}
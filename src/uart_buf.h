@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef UART_BUF_H_
+#define UART_BUF_H_
+
+/** @file
+ *  @brief UART buffers and transmission of the bridge
+ *
+ *  Buffers carrying the UART data through the bridge, and the UART
+ *  transmission queue, which resumes or drops aborted transmissions.
+ *  Separate from main.c so that the buffer lifecycle can be tested on its
+ *  own.
+ */
+
+#include <stdbool.h>
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/uart.h>
+
+#include "buf_track.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CONFIG_BT_NUS_HOT_PATH_RAM)
+/* Executed from RAM without flash wait states, and compiled for speed even
+ * when the image is optimized for size. The functions they call stay in
+ * flash unless inlined, among them k_malloc(), the LOG_* backends,
+ * bt_addr_le_to_str() and memcpy().
+ */
+#if defined(__clang__)
+/* Clang has no optimize attribute, the image optimization level applies. */
+#define HOT_PATH __ramfunc
+#else
+#define HOT_PATH __ramfunc __attribute__((optimize("O2")))
+#endif
+#else
+#define HOT_PATH
+#endif
+
+#define UART_BUF_SIZE CONFIG_BT_NUS_UART_BUFFER_SIZE
+
+struct uart_data_t {
+	void *fifo_reserved;
+	uint8_t data[UART_BUF_SIZE];
+	uint16_t len;
+	/* Cycle count at which the first byte was received. */
+	uint32_t timestamp;
+#if defined(CONFIG_BT_NUS_LANES)
+	/* Classified for the high priority lane. */
+	bool prio;
+#endif
+#if defined(CONFIG_BT_NUS_DEADLINE)
+	/* Received bytes already copied out and handed over. */
+	uint16_t handed;
+#endif
+#if defined(CONFIG_BT_NUS_BUF_TRACKING)
+	struct buf_track track;
+#endif
+};
+
+#if defined(CONFIG_BT_NUS_BUF_TRACKING)
+#define UART_BUF_OWNER(_buf, _owner) buf_track_owner(&(_buf)->track, (_owner))
+#else
+#define UART_BUF_OWNER(_buf, _owner)
+#endif
+
+/** @brief Allocate an empty UART buffer.
+ *
+ *  Fails periodically with CONFIG_BT_NUS_FAULT_INJECTION.
+ *
+ *  @param site Allocation site, recorded by the buffer tracking.
+ *
+ *  @return The buffer, or NULL if none is available.
+ */
+struct uart_data_t *uart_buf_alloc_at(const char *site);
+
+#define uart_buf_alloc() uart_buf_alloc_at(__func__)
+
+/** @brief Free a UART buffer.
+ *
+ *  @param buf Buffer to free.
+ */
+void uart_buf_free(struct uart_data_t *buf);
+
+/** @brief Reschedule a work item once the next buffer is freed.
+ *
+ *  @param work Work item restarting what waits for a buffer.
+ */
+void uart_buf_wait(struct k_work_delayable *work);
+
+/** @brief Set the UART the buffers are transmitted on.
+ *
+ *  @param dev UART device.
+ */
+void uart_tx_init(const struct device *dev);
+
+/** @brief Start the transmission of a buffer.
+ *
+ *  @param buf    Buffer to transmit.
+ *  @param offset Offset of the first byte to transmit.
+ *
+ *  @return 0 on success, negative error code from uart_tx() otherwise.
+ */
+int uart_tx_start(struct uart_data_t *buf, size_t offset);
+
+/** @brief Transmit a buffer, or queue it behind the ongoing transmission.
+ *
+ *  @param buf Buffer to transmit.
+ */
+void uart_tx_send(struct uart_data_t *buf);
+
+/** @brief Handle the UART_TX_DONE and UART_TX_ABORTED events.
+ *
+ *  A transmission aborted by uart_tx_drop() is dropped, any other one is
+ *  resumed where it stopped. The next queued buffer is transmitted once
+ *  the buffer is done with.
+ *
+ *  @param evt UART event.
+ */
+void uart_tx_event(const struct uart_event *evt);
+
+/** @brief Check whether a buffer is being transmitted or queued.
+ *
+ *  @return true if the transmitter is busy.
+ */
+bool uart_tx_busy(void);
+
+/** @brief Get the ongoing transmission.
+ *
+ *  @param len   Length of the transmission, may be NULL.
+ *  @param start Uptime at which it started, may be NULL.
+ *
+ *  @return true if a buffer is being transmitted.
+ */
+bool uart_tx_ongoing(size_t *len, int64_t *start);
+
+/** @brief Drop the ongoing transmission, or start the next one if none.
+ *
+ *  Used to recover from a stalled transmitter.
+ */
+void uart_tx_drop(void);
+
+/** @brief Drop the buffers waiting for transmission. */
+void uart_tx_queue_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UART_BUF_H_ */
@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/sys/atomic.h>
+
+#include <bluetooth/services/nus.h>
+
+#include <zephyr/logging/log.h>
+
+#include "bridge_stats.h"
+#include "uart_chan.h"
+
+LOG_MODULE_DECLARE(peripheral_uart);
+
+#define CHAN_NODE DT_PATH(zephyr_user)
+
+BUILD_ASSERT(DT_NODE_HAS_PROP(CHAN_NODE, nus_uarts),
+	     "The zephyr,user node must list the channel UARTs in nus-uarts");
+BUILD_ASSERT(DT_PROP_LEN(CHAN_NODE, nus_uarts) == DT_PROP_LEN(CHAN_NODE, nus_uart_priorities),
+	     "nus-uart-priorities must hold one priority per nus-uarts entry");
+
+#define CHAN_COUNT DT_PROP_LEN(CHAN_NODE, nus_uarts)
+#define CHAN_BUF_SIZE CONFIG_BT_NUS_UART_CHANNEL_BUF_SIZE
+#define CHAN_RX_TIMEOUT CONFIG_BT_NUS_UART_RX_WAIT_TIME
+
+struct chan_buf {
+	void *fifo_reserved;
+	uint16_t len;
+	/* Channel header, sent along with the data that follows it. */
+	struct uart_chan_hdr hdr;
+	uint8_t data[CHAN_BUF_SIZE];
+};
+
+#define CHAN_BLOCK_SIZE ROUND_UP(sizeof(struct chan_buf), sizeof(void *))
+
+struct uart_chan {
+	const struct device *dev;
+	uint8_t id;
+	int prio;
+
+	/* Buffers of the channel, reserved for each direction so that data
+	 * written over Bluetooth LE never takes the reception buffers.
+	 */
+	struct k_mem_slab rx_slab;
+	struct k_mem_slab tx_slab;
+	struct k_fifo rx_fifo;
+	struct k_fifo tx_fifo;
+
+	/* Reception double buffer. */
+	uint8_t rx_dma[2][CHAN_BUF_SIZE];
+	uint8_t rx_next;
+	/* Reception is stopped until a buffer is freed. */
+	atomic_t rx_paused;
+
+	struct k_spinlock tx_lock;
+	struct chan_buf *tx_buf;
+
+	struct k_thread thread;
+};
+
+#define CHAN_INIT(node, prop, idx)							\
+	{										\
+		.dev = DEVICE_DT_GET(DT_PHANDLE_BY_IDX(node, prop, idx)),		\
+		.id = (idx) + 1,							\
+		.prio = DT_PROP_BY_IDX(node, nus_uart_priorities, idx),			\
+	},
+
+static struct uart_chan chans[] = {
+	DT_FOREACH_PROP_ELEM(CHAN_NODE, nus_uarts, CHAN_INIT)
+};
+
+static char __aligned(sizeof(void *))
+	rx_slab_mem[CHAN_COUNT][CONFIG_BT_NUS_UART_CHANNEL_RX_BUF_COUNT * CHAN_BLOCK_SIZE];
+static char __aligned(sizeof(void *))
+	tx_slab_mem[CHAN_COUNT][CONFIG_BT_NUS_UART_CHANNEL_TX_BUF_COUNT * CHAN_BLOCK_SIZE];
+
+static K_THREAD_STACK_ARRAY_DEFINE(chan_stacks, CHAN_COUNT, CONFIG_BT_NUS_THREAD_STACK_SIZE);
+
+static struct chan_buf *chan_buf_alloc(struct uart_chan *chan, struct k_mem_slab *slab)
+{
+	struct chan_buf *buf;
+
+	if (k_mem_slab_alloc(slab, (void **)&buf, K_NO_WAIT)) {
+		return NULL;
+	}
+
+	buf->len = 0;
+	buf->hdr.chan = chan->id;
+
+	return buf;
+}
+
+static int chan_rx_enable(struct uart_chan *chan)
+{
+	int err;
+
+	err = uart_rx_enable(chan->dev, chan->rx_dma[chan->rx_next], CHAN_BUF_SIZE,
+			     CHAN_RX_TIMEOUT);
+	if (!err) {
+		chan->rx_next ^= 1;
+	}
+
+	return err;
+}
+
+static void chan_rx_resume(struct uart_chan *chan)
+{
+	int err;
+
+	if (!atomic_cas(&chan->rx_paused, 1, 0)) {
+		return;
+	}
+
+	err = chan_rx_enable(chan);
+	if (err && (err != -EBUSY)) {
+		LOG_WRN("Cannot resume reception on channel %u (err %d)", chan->id, err);
+	}
+}
+
+static void chan_tx_next(struct uart_chan *chan)
+{
+	k_spinlock_key_t key = k_spin_lock(&chan->tx_lock);
+	struct chan_buf *buf;
+
+	if (chan->tx_buf) {
+		k_mem_slab_free(&chan->tx_slab, chan->tx_buf);
+	}
+
+	buf = k_fifo_get(&chan->tx_fifo, K_NO_WAIT);
+	chan->tx_buf = buf;
+
+	k_spin_unlock(&chan->tx_lock, key);
+
+	if (buf && uart_tx(chan->dev, buf->data, buf->len, SYS_FOREVER_MS)) {
+		BRIDGE_STATS_INCN(uart_tx_drop, buf->len);
+		chan_tx_next(chan);
+	}
+}
+
+static void chan_uart_cb(const struct device *dev, struct uart_event *evt, void *user_data)
+{
+	struct uart_chan *chan = user_data;
+	struct chan_buf *buf;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		chan_tx_next(chan);
+		break;
+
+	case UART_RX_RDY:
+		BRIDGE_STATS_INCN(uart_rx_bytes, evt->data.rx.len);
+
+		buf = chan_buf_alloc(chan, &chan->rx_slab);
+		if (!buf) {
+			BRIDGE_STATS_INCN(chan_rx_drop, evt->data.rx.len);
+			break;
+		}
+
+		memcpy(buf->data, &evt->data.rx.buf[evt->data.rx.offset], evt->data.rx.len);
+		buf->len = evt->data.rx.len;
+		k_fifo_put(&chan->rx_fifo, buf);
+
+		/* Stop receiving rather than losing data once the channel
+		 * runs out of reception buffers, the hardware flow control,
+		 * if any, then holds the sender.
+		 */
+		if (k_mem_slab_num_free_get(&chan->rx_slab) == 0) {
+			atomic_set(&chan->rx_paused, 1);
+			BRIDGE_STATS_INC(chan_rx_paused);
+			uart_rx_disable(dev);
+		}
+		break;
+
+	case UART_RX_BUF_REQUEST:
+		if (!atomic_get(&chan->rx_paused)) {
+			uart_rx_buf_rsp(dev, chan->rx_dma[chan->rx_next], CHAN_BUF_SIZE);
+			chan->rx_next ^= 1;
+		}
+		break;
+
+	case UART_RX_DISABLED:
+		if (!atomic_get(&chan->rx_paused)) {
+			chan_rx_enable(chan);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+int uart_chan_write(uint8_t id, const uint8_t *data, uint16_t len)
+{
+	struct uart_chan *chan;
+	k_spinlock_key_t key;
+	bool start = false;
+
+	if ((id == UART_CHAN_PRIMARY) || (id > ARRAY_SIZE(chans))) {
+		return -EINVAL;
+	}
+
+	chan = &chans[id - 1];
+
+	for (uint16_t pos = 0; pos < len;) {
+		struct chan_buf *buf = chan_buf_alloc(chan, &chan->tx_slab);
+
+		if (!buf) {
+			BRIDGE_STATS_INCN(ble_rx_drop, len - pos);
+			return -ENOMEM;
+		}
+
+		buf->len = MIN(len - pos, CHAN_BUF_SIZE);
+		memcpy(buf->data, &data[pos], buf->len);
+		pos += buf->len;
+
+		key = k_spin_lock(&chan->tx_lock);
+		if (chan->tx_buf) {
+			k_fifo_put(&chan->tx_fifo, buf);
+		} else {
+			chan->tx_buf = buf;
+			start = true;
+		}
+		k_spin_unlock(&chan->tx_lock, key);
+
+		if (start && uart_tx(chan->dev, buf->data, buf->len, SYS_FOREVER_MS)) {
+			BRIDGE_STATS_INCN(uart_tx_drop, buf->len);
+			chan_tx_next(chan);
+		}
+
+		start = false;
+	}
+
+	return 0;
+}
+
+static void chan_thread(void *p1, void *p2, void *p3)
+{
+	struct uart_chan *chan = p1;
+
+	for (;;) {
+		struct chan_buf *buf = k_fifo_get(&chan->rx_fifo, K_FOREVER);
+		int err;
+
+		err = bt_nus_send(NULL, (const uint8_t *)&buf->hdr, sizeof(buf->hdr) + buf->len);
+		if (err) {
+			BRIDGE_STATS_INC(ble_tx_fail);
+		} else {
+			BRIDGE_STATS_INC(ble_tx_pkts);
+			BRIDGE_STATS_INCN(ble_tx_bytes, buf->len);
+		}
+
+		k_mem_slab_free(&chan->rx_slab, buf);
+		chan_rx_resume(chan);
+	}
+}
+
+int uart_chan_init(void)
+{
+	int err;
+
+	for (size_t i = 0; i < ARRAY_SIZE(chans); i++) {
+		struct uart_chan *chan = &chans[i];
+
+		if (!device_is_ready(chan->dev)) {
+			LOG_ERR("UART of channel %u not ready", chan->id);
+			return -ENODEV;
+		}
+
+		k_mem_slab_init(&chan->rx_slab, rx_slab_mem[i], CHAN_BLOCK_SIZE,
+				CONFIG_BT_NUS_UART_CHANNEL_RX_BUF_COUNT);
+		k_mem_slab_init(&chan->tx_slab, tx_slab_mem[i], CHAN_BLOCK_SIZE,
+				CONFIG_BT_NUS_UART_CHANNEL_TX_BUF_COUNT);
+		k_fifo_init(&chan->rx_fifo);
+		k_fifo_init(&chan->tx_fifo);
+
+		err = uart_callback_set(chan->dev, chan_uart_cb, chan);
+		if (err) {
+			LOG_ERR("Cannot set callback of channel %u (err %d)", chan->id, err);
+			return err;
+		}
+
+		k_thread_create(&chan->thread, chan_stacks[i], K_THREAD_STACK_SIZEOF(chan_stacks[i]),
+				chan_thread, chan, NULL, NULL, chan->prio, 0, K_NO_WAIT);
+
+		err = chan_rx_enable(chan);
+		if (err) {
+			LOG_ERR("Cannot enable reception on channel %u (err %d)", chan->id, err);
+			return err;
+		}
+
+		LOG_INF("UART channel %u on %s, priority %d", chan->id, chan->dev->name,
+			chan->prio);
+	}
+
+	return 0;
+}
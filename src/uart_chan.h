@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef UART_CHAN_H_
+#define UART_CHAN_H_
+
+/** @file
+ *  @brief Additional UART channels
+ *
+ *  Bridges the UARTs listed in the nus-uarts property of the zephyr,user
+ *  devicetree node, in addition to the nordic,nus-uart one, over the same
+ *  NUS connection. Every notification and write then starts with a one
+ *  byte channel header: 0 for the nordic,nus-uart UART, and 1 onwards for
+ *  the UARTs in nus-uarts order.
+ *
+ *  Each channel has its own buffers, so that a channel that is not read
+ *  fast enough only pauses its own reception, and its own sender thread,
+ *  whose priority is set by the nus-uart-priorities property.
+ */
+
+#include <zephyr/types.h>
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Channel of the nordic,nus-uart UART. */
+#define UART_CHAN_PRIMARY 0
+
+/** Channel header, followed by the channel data. */
+struct uart_chan_hdr {
+	/** Channel identifier. */
+	uint8_t chan;
+} __packed;
+
+#if defined(CONFIG_BT_NUS_UART_CHANNELS)
+
+/** @brief Start the additional UART channels.
+ *
+ *  @return 0 on success, negative error code otherwise.
+ */
+int uart_chan_init(void);
+
+/** @brief Write data received over NUS to an additional channel.
+ *
+ *  @param chan Channel identifier, from 1.
+ *  @param data Data to write.
+ *  @param len  Data length.
+ *
+ *  @retval 0 on success.
+ *  @retval -EINVAL if the channel does not exist.
+ *  @retval -ENOMEM if the channel has no free buffer, the data is dropped.
+ */
+int uart_chan_write(uint8_t chan, const uint8_t *data, uint16_t len);
+
+#else
+
+static inline int uart_chan_init(void)
+{
+	return 0;
+}
+
+static inline int uart_chan_write(uint8_t chan, const uint8_t *data, uint16_t len)
+{
+	ARG_UNUSED(chan);
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+
+	return -EINVAL;
+}
+
+#endif /* CONFIG_BT_NUS_UART_CHANNELS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UART_CHAN_H_ */
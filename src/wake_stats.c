@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+
+#include <cmsis_core.h>
+#include <zephyr/kernel.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/init.h>
+#include <zephyr/sys/math_extras.h>
+
+#include <tracing_user.h>
+
+#include <zephyr/logging/log.h>
+
+#include "bridge_stats.h"
+
+LOG_MODULE_DECLARE(peripheral_uart);
+
+/* Exception number of the first external interrupt. */
+#define IRQ_BASE 16
+#define EXC_COUNT (IRQ_BASE + CONFIG_NUM_IRQS)
+#define SYSTICK_EXC 15
+
+#if defined(CONFIG_NRF_RTC_TIMER)
+#define SYS_TIMER_EXC (IRQ_BASE + DT_IRQN(DT_NODELABEL(rtc1)))
+#elif defined(CONFIG_CORTEX_M_SYSTICK)
+#define SYS_TIMER_EXC SYSTICK_EXC
+#else
+#define SYS_TIMER_EXC EXC_COUNT
+#endif
+
+#if DT_IRQ_HAS_IDX(DT_CHOSEN(nordic_nus_uart), 0)
+#define UART_EXC (IRQ_BASE + DT_IRQN(DT_CHOSEN(nordic_nus_uart)))
+#else
+#define UART_EXC EXC_COUNT
+#endif
+
+/* The CPU sleeps until the next interrupt. */
+static atomic_t idle;
+/* Wake-ups per exception number since the last report. */
+static uint32_t wakeups[EXC_COUNT];
+static struct k_work_delayable report_work;
+
+void sys_trace_idle_user(void)
+{
+	atomic_set(&idle, 1);
+}
+
+/* Called once the CPU woke up, with interrupts still masked. The waking
+ * interrupts are pending, including the direct and zero latency ones of
+ * the radio protocol stacks, which bypass the ISR tracing hooks.
+ */
+void sys_trace_idle_exit_user(void)
+{
+	bool found = false;
+
+	if (!atomic_cas(&idle, 1, 0)) {
+		return;
+	}
+
+	if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) {
+		wakeups[SYSTICK_EXC]++;
+		found = true;
+	}
+
+	for (size_t i = 0; i < DIV_ROUND_UP(CONFIG_NUM_IRQS, 32); i++) {
+		uint32_t pending = NVIC->ISPR[i] & NVIC->ISER[i];
+
+		while (pending) {
+			uint32_t irq = i * 32 + u32_count_trailing_zeros(pending);
+
+			pending &= pending - 1;
+
+			if (irq < CONFIG_NUM_IRQS) {
+				wakeups[IRQ_BASE + irq]++;
+				found = true;
+			}
+		}
+	}
+
+	/* Interrupts were not masked, the ISR tracing hook counts it. */
+	if (!found) {
+		atomic_set(&idle, 1);
+	}
+}
+
+void sys_trace_isr_enter_user(int nested_interrupts)
+{
+	uint32_t exc = __get_IPSR();
+
+	ARG_UNUSED(nested_interrupts);
+
+	/* Only the first interrupt after idle woke the CPU up, the threads
+	 * it readies run before idle is entered again.
+	 */
+	if ((exc >= EXC_COUNT) || !atomic_cas(&idle, 1, 0)) {
+		return;
+	}
+
+	wakeups[exc]++;
+}
+
+static uint32_t per_second(uint32_t count)
+{
+	return DIV_ROUND_CLOSEST(count * MSEC_PER_SEC, CONFIG_BT_NUS_WAKE_STATS_REPORT_INTERVAL);
+}
+
+static uint32_t exc_per_second(const uint32_t *counts, uint32_t exc)
+{
+	return (exc < EXC_COUNT) ? per_second(counts[exc]) : 0;
+}
+
+static void report_work_handler(struct k_work *work)
+{
+	uint32_t counts[EXC_COUNT];
+	uint32_t total = 0;
+	unsigned int key;
+
+	key = irq_lock();
+	memcpy(counts, wakeups, sizeof(counts));
+	memset(wakeups, 0, sizeof(wakeups));
+	irq_unlock(key);
+
+	k_work_reschedule(&report_work, K_MSEC(CONFIG_BT_NUS_WAKE_STATS_REPORT_INTERVAL));
+
+	for (size_t exc = 0; exc < ARRAY_SIZE(counts); exc++) {
+		if (counts[exc] == 0) {
+			continue;
+		}
+
+		total += counts[exc];
+
+		if (exc < IRQ_BASE) {
+			LOG_DBG("Exception %u: %u wake-ups/s", exc, per_second(counts[exc]));
+		} else {
+			LOG_DBG("IRQ %u: %u wake-ups/s", exc - IRQ_BASE, per_second(counts[exc]));
+		}
+	}
+
+	BRIDGE_STATS_SET(wk_total_ps, per_second(total));
+	BRIDGE_STATS_SET(wk_timer_ps, exc_per_second(counts, SYS_TIMER_EXC));
+	BRIDGE_STATS_SET(wk_uart_ps, exc_per_second(counts, UART_EXC));
+
+	LOG_INF("CPU wake-ups: %u/s, system timer %u/s, UART %u/s", bridge_stats.wk_total_ps,
+		bridge_stats.wk_timer_ps, bridge_stats.wk_uart_ps);
+}
+
+static int wake_stats_sys_init(void)
+{
+	k_work_init_delayable(&report_work, report_work_handler);
+	k_work_reschedule(&report_work, K_MSEC(CONFIG_BT_NUS_WAKE_STATS_REPORT_INTERVAL));
+
+	return 0;
+}
+
+SYS_INIT(wake_stats_sys_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,30 @@
+#!/usr/bin/env bash
+# Copyright (c) 2026 Nordic Semiconductor ASA
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+# Build the tester and two relays of the peripheral_uart sample
+set -ue
+
+: "${ZEPHYR_BASE:?ZEPHYR_BASE must be set to point to the zephyr root directory}"
+
+source ${ZEPHYR_BASE}/tests/bsim/compile.source
+
+app_root=$(cd "$(dirname "${BASH_SOURCE[0]}")/../../.." && pwd)
+
+app=tests/bsim/relay exe_name=bs_${BOARD_TS}_peripheral_uart_relay_tester compile
+
+app=. conf_overlay=overlay-relay.conf \
+  exe_name=bs_${BOARD_TS}_peripheral_uart_relay_1 \
+  cmake_extra_args="-DCONFIG_BT_NUS_RELAY_TRACE=y \
+    -DCONFIG_BT_DEVICE_NAME=\"NUS_Relay_1\" \
+    -DCONFIG_BT_NUS_CENTRAL_PEER_NAME=\"Nordic_UART_Service\"" \
+  compile
+
+app=. conf_overlay=overlay-relay.conf \
+  exe_name=bs_${BOARD_TS}_peripheral_uart_relay_2 \
+  cmake_extra_args="-DCONFIG_BT_NUS_RELAY_TRACE=y \
+    -DCONFIG_BT_DEVICE_NAME=\"NUS_Relay_2\" \
+    -DCONFIG_BT_NUS_CENTRAL_PEER_NAME=\"NUS_Relay_1\"" \
+  compile
+
+wait_for_background_jobs
@@ -0,0 +1,435 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Tester at both ends of a relay chain: it is the upstream bridge of the
+ * first relay and the downstream bridge of the last one. Being both the
+ * origin and the sink of the traced data, it measures the end-to-end
+ * latency and throughput with a single clock.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <bluetooth/gatt_dm.h>
+#include <bluetooth/scan.h>
+#include <bluetooth/services/nus.h>
+#include <bluetooth/services/nus_client.h>
+
+#include "bs_types.h"
+#include "bs_tracing.h"
+#include "bstests.h"
+
+#include "relay.h"
+
+#define RELAYS 2
+#define LAST_RELAY_NAME "NUS_Relay_2"
+
+#define PACKETS 200
+#define PAYLOAD_SIZE 200
+/* Packets in flight along the chain, enough to keep every hop busy. */
+#define WINDOW 4
+
+/* Bounds on the end-to-end figures in each direction. They are loose on
+ * purpose: the test catches a relay that stalls or serializes the hops,
+ * not small changes of the connection timing.
+ */
+#define MIN_THROUGHPUT_BPS 20000
+#define MAX_LATENCY_US 250000
+
+#define WAIT_SECONDS 50
+#define WAIT_TIME (WAIT_SECONDS * USEC_PER_SEC)
+
+extern enum bst_result_t bst_result;
+
+#define FAIL(...)                                                                                  \
+	do {                                                                                       \
+		bst_result = Failed;                                                               \
+		bs_trace_error_time_line(__VA_ARGS__);                                             \
+	} while (0)
+
+#define PASS(...)                                                                                  \
+	do {                                                                                       \
+		bst_result = Passed;                                                               \
+		bs_trace_info_time(1, __VA_ARGS__);                                                \
+	} while (0)
+
+struct trace_result {
+	uint32_t packets;
+	uint32_t bytes;
+	uint32_t lat_sum_us;
+	uint32_t lat_max_us;
+	uint32_t first_us;
+	uint32_t last_us;
+};
+
+static const struct bt_data ad[] = {
+	BT_DATA_BYTES(BT_DATA_FLAGS, (BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR)),
+	BT_DATA(BT_DATA_NAME_COMPLETE, CONFIG_BT_DEVICE_NAME, sizeof(CONFIG_BT_DEVICE_NAME) - 1),
+	BT_DATA_BYTES(BT_DATA_UUID128_ALL, BT_UUID_NUS_VAL),
+};
+
+static struct bt_nus_client nus_client;
+static struct bt_gatt_exchange_params mtu_params;
+static struct bt_conn *downstream_conn;
+
+static K_SEM_DEFINE(first_relay_ready, 0, 1);
+static K_SEM_DEFINE(last_relay_ready, 0, 1);
+static K_SEM_DEFINE(credits, WINDOW, WINDOW);
+static K_SEM_DEFINE(write_done, 1, 1);
+
+static struct trace_result down;
+static struct trace_result up;
+
+static uint32_t uptime_us(void)
+{
+	return (uint32_t)k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
+static void trace_account(struct trace_result *res, const uint8_t *data, uint16_t len)
+{
+	const struct relay_trace_hdr *hdr = (const void *)data;
+	uint32_t now = uptime_us();
+	uint32_t lat_us;
+
+	if (len != (sizeof(*hdr) + PAYLOAD_SIZE)) {
+		FAIL("Unexpected length %u\n", len);
+		return;
+	}
+
+	if (hdr->hops != RELAYS) {
+		FAIL("Data went through %u relays instead of %u\n", hdr->hops, RELAYS);
+		return;
+	}
+
+	lat_us = now - sys_le32_to_cpu(hdr->origin_us);
+
+	if (res->packets == 0) {
+		res->first_us = now;
+	}
+
+	res->packets++;
+	res->bytes += PAYLOAD_SIZE;
+	res->lat_sum_us += lat_us;
+	res->lat_max_us = MAX(res->lat_max_us, lat_us);
+	res->last_us = now;
+
+	k_sem_give(&credits);
+}
+
+static bool trace_check(const char *dir, const struct trace_result *res)
+{
+	uint32_t span_us = MAX(res->last_us - res->first_us, 1);
+	uint32_t bps = (uint32_t)((uint64_t)(res->bytes - PAYLOAD_SIZE) * 8 * USEC_PER_SEC /
+				  span_us);
+	uint32_t lat_us = res->lat_sum_us / res->packets;
+
+	bs_trace_info_time(1, "%s: %u packets over %u hops, %u bps, latency %u us (max %u us)\n",
+			   dir, res->packets, RELAYS, bps, lat_us, res->lat_max_us);
+
+	if (bps < MIN_THROUGHPUT_BPS) {
+		FAIL("%s throughput %u bps below %u bps\n", dir, bps, MIN_THROUGHPUT_BPS);
+		return false;
+	}
+
+	if (lat_us > MAX_LATENCY_US) {
+		FAIL("%s latency %u us above %u us\n", dir, lat_us, MAX_LATENCY_US);
+		return false;
+	}
+
+	return true;
+}
+
+/* Wait for the packets in flight to come out of the chain. */
+static bool window_drain(const char *dir)
+{
+	for (int i = 0; i < WINDOW; i++) {
+		if (k_sem_take(&credits, K_SECONDS(5))) {
+			FAIL("%s: %d packets still in flight\n", dir, WINDOW - i);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Upstream end: the first relay connects to the NUS service. */
+static void server_received(struct bt_conn *conn, const uint8_t *const data, uint16_t len)
+{
+	trace_account(&up, data, len);
+}
+
+static void server_send_enabled(enum bt_nus_send_status status)
+{
+	if (status == BT_NUS_SEND_STATUS_ENABLED) {
+		k_sem_give(&first_relay_ready);
+	}
+}
+
+static struct bt_nus_cb nus_cb = {
+	.received = server_received,
+	.send_enabled = server_send_enabled,
+};
+
+/* Downstream end: the tester connects to the last relay. */
+static uint8_t client_received(struct bt_nus_client *nus, const uint8_t *data, uint16_t len)
+{
+	trace_account(&down, data, len);
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static void client_sent(struct bt_nus_client *nus, uint8_t err, const uint8_t *const data,
+			uint16_t len)
+{
+	if (err) {
+		FAIL("Write to the last relay failed (err %u)\n", err);
+	}
+
+	k_sem_give(&write_done);
+}
+
+static void discovery_complete(struct bt_gatt_dm *dm, void *context)
+{
+	int err;
+
+	bt_nus_handles_assign(dm, &nus_client);
+	err = bt_nus_subscribe_receive(&nus_client);
+	bt_gatt_dm_data_release(dm);
+
+	if (err) {
+		FAIL("Cannot subscribe to the last relay (err %d)\n", err);
+		return;
+	}
+
+	k_sem_give(&last_relay_ready);
+}
+
+static void discovery_failed(struct bt_conn *conn, void *context)
+{
+	FAIL("NUS service of the last relay not found\n");
+}
+
+static void discovery_error(struct bt_conn *conn, int err, void *context)
+{
+	FAIL("Discovery of the last relay failed (err %d)\n", err);
+}
+
+static const struct bt_gatt_dm_cb discovery_cb = {
+	.completed = discovery_complete,
+	.service_not_found = discovery_failed,
+	.error_found = discovery_error,
+};
+
+static void mtu_exchanged(struct bt_conn *conn, uint8_t err,
+			  struct bt_gatt_exchange_params *params)
+{
+	if (bt_gatt_dm_start(conn, BT_UUID_NUS_SERVICE, &discovery_cb, NULL)) {
+		FAIL("Cannot start the discovery of the last relay\n");
+	}
+}
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	struct bt_conn_info info;
+
+	if (err) {
+		FAIL("Connection failed (err 0x%02x)\n", err);
+		return;
+	}
+
+	if (bt_conn_get_info(conn, &info) || (info.role != BT_CONN_ROLE_CENTRAL)) {
+		return;
+	}
+
+	downstream_conn = bt_conn_ref(conn);
+
+	mtu_params.func = mtu_exchanged;
+	if (bt_gatt_exchange_mtu(conn, &mtu_params)) {
+		FAIL("MTU exchange with the last relay failed\n");
+	}
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	FAIL("Relay disconnected (reason 0x%02x)\n", reason);
+}
+
+BT_CONN_CB_DEFINE(conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+};
+
+static int central_start(void)
+{
+	struct bt_scan_init_param scan_init = {
+		.connect_if_match = true,
+	};
+	struct bt_nus_client_init_param client_init = {
+		.cb = {
+			.received = client_received,
+			.sent = client_sent,
+		},
+	};
+	int err;
+
+	err = bt_nus_client_init(&nus_client, &client_init);
+	if (err) {
+		return err;
+	}
+
+	bt_scan_init(&scan_init);
+
+	err = bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, LAST_RELAY_NAME);
+	if (!err) {
+		err = bt_scan_filter_enable(BT_SCAN_NAME_FILTER, false);
+	}
+
+	if (!err) {
+		err = bt_scan_start(BT_SCAN_TYPE_SCAN_ACTIVE);
+	}
+
+	return err;
+}
+
+static void packet_fill(uint8_t *packet, uint32_t seq)
+{
+	struct relay_trace_hdr *hdr = (void *)packet;
+
+	hdr->origin_us = sys_cpu_to_le32(uptime_us());
+	hdr->hops = 0;
+	memset(&packet[sizeof(struct relay_trace_hdr)], (uint8_t)seq, PAYLOAD_SIZE);
+}
+
+static void test_main(void)
+{
+	static uint8_t packet[sizeof(struct relay_trace_hdr) + PAYLOAD_SIZE];
+	int err;
+
+	err = bt_enable(NULL);
+	if (err) {
+		FAIL("Bluetooth init failed (err %d)\n", err);
+		return;
+	}
+
+	err = bt_nus_init(&nus_cb);
+	if (!err) {
+		err = bt_le_adv_start(BT_LE_ADV_CONN_FAST_1, ad, ARRAY_SIZE(ad), NULL, 0);
+	}
+
+	if (!err) {
+		err = central_start();
+	}
+
+	if (err) {
+		FAIL("Cannot start the tester (err %d)\n", err);
+		return;
+	}
+
+	if (k_sem_take(&first_relay_ready, K_SECONDS(20)) ||
+	    k_sem_take(&last_relay_ready, K_SECONDS(20))) {
+		FAIL("Relay chain not set up\n");
+		return;
+	}
+
+	/* Notifications travel down the chain. */
+	for (uint32_t i = 0; i < PACKETS; i++) {
+		k_sem_take(&credits, K_FOREVER);
+		packet_fill(packet, i);
+
+		while ((err = bt_nus_send(NULL, packet, sizeof(packet))) == -ENOMEM) {
+			k_sleep(K_MSEC(1));
+		}
+
+		if (err) {
+			FAIL("Notification %u failed (err %d)\n", i, err);
+			return;
+		}
+	}
+
+	if (!window_drain("Down")) {
+		return;
+	}
+
+	/* Give the credits back for the other direction. */
+	for (int i = 0; i < WINDOW; i++) {
+		k_sem_give(&credits);
+	}
+
+	/* Writes travel up the chain. */
+	for (uint32_t i = 0; i < PACKETS; i++) {
+		k_sem_take(&credits, K_FOREVER);
+		k_sem_take(&write_done, K_FOREVER);
+		packet_fill(packet, i);
+
+		err = bt_nus_client_send(&nus_client, packet, sizeof(packet));
+		if (err) {
+			FAIL("Write %u failed (err %d)\n", i, err);
+			return;
+		}
+	}
+
+	if (!window_drain("Up")) {
+		return;
+	}
+
+	if ((down.packets != PACKETS) || (up.packets != PACKETS)) {
+		FAIL("Lost data: %u/%u packets down, %u/%u packets up\n", down.packets, PACKETS,
+		     up.packets, PACKETS);
+		return;
+	}
+
+	if (!trace_check("Down", &down) || !trace_check("Up", &up)) {
+		return;
+	}
+
+	PASS("Relay chain test passed\n");
+}
+
+static void test_init(void)
+{
+	bst_ticker_set_next_tick_absolute(WAIT_TIME);
+	bst_result = In_progress;
+}
+
+static void test_tick(bs_time_t HW_device_time)
+{
+	if (bst_result != Passed) {
+		FAIL("Test failed (not passed after %d seconds)\n", WAIT_SECONDS);
+	}
+}
+
+static const struct bst_test_instance test_def[] = {
+	{
+		.test_id = "relay_chain",
+		.test_descr = "Stream traced data across two relays in both directions",
+		.test_pre_init_f = test_init,
+		.test_tick_f = test_tick,
+		.test_main_f = test_main,
+	},
+	BSTEST_END_MARKER
+};
+
+struct bst_test_list *test_relay_install(struct bst_test_list *tests)
+{
+	return bst_add_tests(tests, test_def);
+}
+
+bst_test_install_t test_installers[] = {
+	test_relay_install,
+	NULL
+};
+
+int main(void)
+{
+	bst_main();
+
+	return 0;
+}
@@ -0,0 +1,27 @@
+#!/usr/bin/env bash
+# Copyright (c) 2026 Nordic Semiconductor ASA
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+# Stream traced data across a chain of two relays, in both directions, and
+# check the hop count, end-to-end throughput and latency seen by the tester
+source ${ZEPHYR_BASE}/tests/bsim/sh_common.source
+
+simulation_id="peripheral_uart_relay_chain"
+verbosity_level=2
+EXECUTE_TIMEOUT=120
+
+cd ${BSIM_OUT_PATH}/bin
+
+Execute ./bs_${BOARD_TS}_peripheral_uart_relay_tester \
+  -v=${verbosity_level} -s=${simulation_id} -d=0 -testid=relay_chain
+
+Execute ./bs_${BOARD_TS}_peripheral_uart_relay_1 \
+  -v=${verbosity_level} -s=${simulation_id} -d=1
+
+Execute ./bs_${BOARD_TS}_peripheral_uart_relay_2 \
+  -v=${verbosity_level} -s=${simulation_id} -d=2
+
+Execute ./bs_2G4_phy_v1 -v=${verbosity_level} -s=${simulation_id} \
+  -D=3 -sim_length=60e6 $@
+
+wait_for_background_jobs
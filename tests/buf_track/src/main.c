@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Stress the buffer lifecycle of the bridge the way fault injection does on
+ * hardware: the buffer allocation of the bridge fails periodically, and its
+ * UART transmissions run on the emulated UART, where they are aborted and
+ * either resumed or dropped. Every buffer must be freed exactly once.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/drivers/serial/uart_emul.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+
+#include "buf_track.h"
+#include "uart_buf.h"
+
+LOG_MODULE_REGISTER(peripheral_uart);
+
+/* Longest time for the transmissions to complete once all are queued. */
+#define DRAIN_TIMEOUT_MS 10000
+
+static const struct device *uart = DEVICE_DT_GET(DT_NODELABEL(euart0));
+
+static uint32_t alloc_failures;
+static uint32_t tx_resumes;
+static uint32_t tx_drops;
+static uint32_t tx_bytes;
+
+/* Forwards the transmission events as uart_cb() of the sample does. */
+static void uart_cb(const struct device *dev, struct uart_event *evt, void *user_data)
+{
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		uart_tx_event(evt);
+		break;
+	default:
+		break;
+	}
+}
+
+/* Reads back what the emulated UART transmitted, not to fill it up. */
+static void tx_data_ready(const struct device *dev, size_t size, void *user_data)
+{
+	uint8_t data[32];
+	uint32_t len;
+
+	while ((len = uart_emul_get_tx_data(dev, data, sizeof(data))) > 0) {
+		tx_bytes += len;
+	}
+}
+
+static void *buf_track_setup(void)
+{
+	zassert_true(device_is_ready(uart));
+	zassert_ok(uart_callback_set(uart, uart_cb, NULL));
+	uart_emul_callback_tx_data_ready_set(uart, tx_data_ready, NULL);
+	uart_tx_init(uart);
+
+	return NULL;
+}
+
+ZTEST(buf_track, test_first_alloc)
+{
+	struct uart_data_t *buf;
+	bool failed = false;
+
+	/* Fault injection fails one allocation out of the rate. */
+	for (int i = 0; i < CONFIG_BT_NUS_FAULT_ALLOC_FAIL_RATE; i++) {
+		buf = uart_buf_alloc();
+		if (!buf) {
+			zassert_false(failed, "Allocation %d failed again", i);
+			failed = true;
+			continue;
+		}
+
+		uart_buf_free(buf);
+	}
+
+	zassert_true(failed, "Fault injection did not trigger");
+	zassert_equal(buf_track_outstanding(), 0);
+}
+
+ZTEST(buf_track, test_double_free)
+{
+	uint32_t double_frees = buf_track_double_frees();
+	struct uart_data_t *buf;
+
+	do {
+		buf = uart_buf_alloc();
+	} while (!buf);
+
+	zassert_equal(buf_track_outstanding(), 1);
+
+	uart_buf_free(buf);
+
+	/* The buffer is freed memory now, it must only be looked up. */
+	uart_buf_free(buf);
+	zassert_equal(buf_track_double_frees(), double_frees + 1);
+	zassert_equal(buf_track_outstanding(), 0);
+}
+
+ZTEST(buf_track, test_stress)
+{
+	uint32_t double_frees = buf_track_double_frees();
+	int64_t start;
+
+	for (uint32_t i = 0; i < CONFIG_STRESS_ITERATIONS; i++) {
+		struct uart_data_t *buf = uart_buf_alloc();
+
+		if (!buf) {
+			alloc_failures++;
+			k_sleep(K_MSEC(1));
+			continue;
+		}
+
+		buf->len = 1 + (i % sizeof(buf->data));
+		memset(buf->data, (uint8_t)i, buf->len);
+		uart_tx_send(buf);
+
+		if ((i % CONFIG_STRESS_TX_ABORT_RATE) != 0) {
+			continue;
+		}
+
+		/* Every other abort resumes the transmission where it
+		 * stopped, the others drop it as the health monitor does.
+		 */
+		if ((i / CONFIG_STRESS_TX_ABORT_RATE) & 1) {
+			if (!uart_tx_abort(uart)) {
+				tx_resumes++;
+			}
+		} else if (uart_tx_ongoing(NULL, NULL)) {
+			uart_tx_drop();
+			tx_drops++;
+		}
+
+		k_yield();
+	}
+
+	start = k_uptime_get();
+
+	while (uart_tx_busy() && ((k_uptime_get() - start) < DRAIN_TIMEOUT_MS)) {
+		k_sleep(K_MSEC(1));
+	}
+
+	buf_track_report();
+
+	zassert_false(uart_tx_busy(), "Transmissions did not complete");
+	zassert_true(alloc_failures > 0, "Fault injection did not trigger");
+	zassert_true(tx_resumes > 0, "No transmission was resumed");
+	zassert_true(tx_drops > 0, "No transmission was dropped");
+	zassert_true(tx_bytes > 0, "Nothing was transmitted");
+	zassert_equal(buf_track_outstanding(), 0, "%u buffers leaked",
+		      buf_track_outstanding());
+	zassert_equal(buf_track_double_frees(), double_frees);
+}
+
+ZTEST_SUITE(buf_track, NULL, buf_track_setup, NULL, NULL, NULL);